@@ -0,0 +1,45 @@
+#include "hexa_Bench.h"
+
+#include <hexa/filters/hexa_ActiveOnePoleFilter.h>
+
+namespace
+{
+	template <typename Type>
+	void benchActiveOnePole(hexa::bench::Runner& runner)
+	{
+		constexpr size_t blockSize = 512;
+		const char* type = hexa::bench::typeName<Type>();
+
+		for (size_t nChans : { 1, 2, 8 })
+		{
+			hexa::bench::PlanarBuffer<Type> in(nChans, blockSize), out(nChans, blockSize);
+			in.fillNoise();
+
+			hexa::ActiveOnePoleFilter<Type> filter;
+			filter.prepare(Type(48000), nChans, blockSize);
+			filter.setFrequency(Type(2000));
+			filter.setDrive(Type(12));
+
+			runner.run("ActiveOnePole DampedNewton", type, nChans, blockSize, [&]
+			{
+				filter.process(in.in(), out.out(), nChans, blockSize);
+			});
+			runner.reportSolverStats("ActiveOnePole DampedNewton", filter.getSolverStats());
+
+			filter.setSolver(hexa::ActiveOnePoleSolver::FixedNewton);
+			filter.resetSolverStats();
+
+			runner.run("ActiveOnePole FixedNewton", type, nChans, blockSize, [&]
+			{
+				filter.process(in.in(), out.out(), nChans, blockSize);
+			});
+			runner.reportSolverStats("ActiveOnePole FixedNewton", filter.getSolverStats());
+		}
+	}
+}
+
+HEXA_BENCH_SUITE(ActiveOnePoleFilter)
+{
+	benchActiveOnePole<float>(runner);
+	benchActiveOnePole<double>(runner);
+}
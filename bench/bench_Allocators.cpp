@@ -0,0 +1,68 @@
+#include "hexa_Bench.h"
+
+#include <memory>
+#include <vector>
+
+#include <hexa/core/hexa_Allocators.h>
+#include <hexa/core/hexa_DelayLine.h>
+
+namespace
+{
+	constexpr size_t numInstances = 256;
+	constexpr int delaySize = 4800;
+	constexpr size_t numChannels = 2;
+
+	template <typename Alloc>
+	using Delay = hexa::DelayLine<float, hexa::InterpolationType::Linear, Alloc>;
+
+	/** Creates numInstances delay lines, then resizes them as prepare() at a doubled rate would. */
+	template <typename Alloc>
+	void createAndPrepare(std::vector<std::unique_ptr<Delay<Alloc>>>& delays)
+	{
+		for (size_t i = 0; i < numInstances; ++i) delays.push_back(std::make_unique<Delay<Alloc>>(delaySize, numChannels));
+		for (auto& d : delays) d->resize(2 * delaySize, numChannels);
+
+		hexa::bench::doNotOptimize(delays.back()->getMaxSize());
+	}
+
+	void benchAllocators(hexa::bench::Runner& runner)
+	{
+		const char* type = hexa::bench::typeName<float>();
+
+		// Per instance: the initial DataBuffer, the buffer at delaySize and at 2 * delaySize
+		const size_t maxBytes = Delay<std::allocator<float>>::getAllocationSize(2 * delaySize, numChannels);
+
+		runner.run("DelayLine create+prepare heap (per instance)", type, 1, numInstances, [&]
+		{
+			std::vector<std::unique_ptr<Delay<std::allocator<float>>>> delays;
+			createAndPrepare(delays);
+		});
+
+		hexa::Arena arena(3 * maxBytes * numInstances);
+		runner.run("DelayLine create+prepare arena (per instance)", type, 1, numInstances, [&]
+		{
+			std::vector<std::unique_ptr<Delay<hexa::ArenaAllocator<float>>>> delays;
+			{
+				hexa::ScopedResource<hexa::Arena> scope(arena);
+				createAndPrepare(delays);
+			}
+
+			delays.clear();
+			arena.reset();
+		});
+
+		// Every allocation of an instance takes a block, resizing holds two sample buffers at once.
+		hexa::Pool pool(maxBytes, numInstances * Delay<hexa::PoolAllocator<float>>::numAllocations + 1);
+		runner.run("DelayLine create+prepare pool (per instance)", type, 1, numInstances, [&]
+		{
+			std::vector<std::unique_ptr<Delay<hexa::PoolAllocator<float>>>> delays;
+			hexa::ScopedResource<hexa::Pool> scope(pool);
+			createAndPrepare(delays);
+		});
+	}
+}
+
+HEXA_BENCH_SUITE(Allocators)
+{
+	benchAllocators(runner);
+}
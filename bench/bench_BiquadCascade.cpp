@@ -0,0 +1,53 @@
+#include "hexa_Bench.h"
+
+#include <array>
+
+#include <hexa/filters/hexa_BiquadCascade.h>
+
+namespace
+{
+	template <typename Type>
+	void benchCascade(hexa::bench::Runner& runner)
+	{
+		constexpr size_t numBands = 8;
+		constexpr size_t blockSize = 512;
+
+		for (size_t nChans : { 2, 16 })
+		{
+			hexa::bench::PlanarBuffer<Type> io(nChans, blockSize);
+			io.fillNoise();
+
+			hexa::BiquadCascade<Type, numBands> cascade;
+			std::array<hexa::RBJFilter<Type>, numBands> bands;
+
+			cascade.prepare(Type(48000), nChans, blockSize);
+			for (size_t i = 0; i < numBands; ++i)
+			{
+				const Type freq = Type(60) * Type(1 << i);
+				cascade.setSection(i, hexa::RBJFilterType::peak, freq, Type(1), Type(3));
+
+				bands[i].prepare(Type(48000), nChans, blockSize);
+				bands[i].setType(hexa::RBJFilterType::peak);
+				bands[i].setCutoff(freq);
+				bands[i].setQ(Type(1));
+				bands[i].setGain(Type(3));
+			}
+
+			runner.run("RBJFilter x8", hexa::bench::typeName<Type>(), nChans, blockSize, [&]
+			{
+				for (auto&& band : bands) band.process(io.in(), io.out(), nChans, blockSize);
+			});
+
+			runner.run("BiquadCascade<8>", hexa::bench::typeName<Type>(), nChans, blockSize, [&]
+			{
+				cascade.process(io.in(), io.out(), nChans, blockSize);
+			});
+		}
+	}
+}
+
+HEXA_BENCH_SUITE(BiquadCascade)
+{
+	benchCascade<float>(runner);
+	benchCascade<double>(runner);
+}
@@ -0,0 +1,144 @@
+#include "hexa_Bench.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include <hexa/core/hexa_Chain.h>
+#include <hexa/filters/hexa_OnePoleFilter.h>
+#include <hexa/filters/hexa_RBJFilter.h>
+#include <hexa/filters/hexa_StateVariableFilter.h>
+#include <hexa/filters/hexa_SymDiodeClipper.h>
+
+namespace
+{
+	template <typename Type>
+	void setupStages(hexa::OnePoleFilter<Type>& hp, hexa::StateVariableFilter<Type>& shelf, hexa::RBJFilter<Type>& lp)
+	{
+		hp.setType(hexa::OnePoleType::HP);
+		hp.setCutoff(Type(30));
+
+		shelf.setType(hexa::StateVariableType::LS);
+		shelf.setCutoff(Type(250));
+		shelf.setGain(Type(4));
+
+		lp.setType(hexa::RBJFilterType::LP);
+		lp.setCutoff(Type(12000));
+	}
+
+	// HP -> low shelf -> (clipper ->) LP: each stage's process() over the block, against
+	// one Chain loop.
+	template <typename Type, bool withClipper>
+	void benchStrip(hexa::bench::Runner& runner, const std::string& name)
+	{
+		constexpr size_t blockSize = 512;
+		const char* type = hexa::bench::typeName<Type>();
+
+		for (size_t nChans : { 1, 2, 8 })
+		{
+			hexa::bench::PlanarBuffer<Type> in(nChans, blockSize), out(nChans, blockSize);
+			in.fillNoise();
+
+			hexa::OnePoleFilter<Type> hp;
+			hexa::StateVariableFilter<Type> shelf;
+			hexa::SymDiodeClipper<Type> clipper;
+			hexa::RBJFilter<Type> lp;
+
+			hp.prepare(Type(48000), nChans, blockSize);
+			shelf.prepare(Type(48000), nChans, blockSize);
+			clipper.prepare(Type(48000), nChans, blockSize);
+			lp.prepare(Type(48000), nChans, blockSize);
+			setupStages(hp, shelf, lp);
+			clipper.setSolver(hexa::DiodeClipperSolver::Table);
+
+			runner.run(name + " sequential", type, nChans, blockSize, [&]
+			{
+				hp.process(in.in(), out.out(), nChans, blockSize);
+				shelf.process(out.in(), out.out(), nChans, blockSize);
+				if constexpr (withClipper) clipper.process(out.in(), out.out(), nChans, blockSize);
+				lp.process(out.in(), out.out(), nChans, blockSize);
+			});
+
+			if constexpr (withClipper)
+			{
+				hexa::Chain<hexa::OnePoleFilter<Type>, hexa::StateVariableFilter<Type>, hexa::SymDiodeClipper<Type>, hexa::RBJFilter<Type>> chain;
+				chain.prepare(Type(48000), nChans, blockSize);
+				setupStages(chain.template get<0>(), chain.template get<1>(), chain.template get<3>());
+				chain.template get<2>().setSolver(hexa::DiodeClipperSolver::Table);
+
+				runner.run(name + " Chain", type, nChans, blockSize, [&]
+				{
+					chain.process(in.in(), out.out(), nChans, blockSize);
+				});
+			}
+			else
+			{
+				hexa::Chain<hexa::OnePoleFilter<Type>, hexa::StateVariableFilter<Type>, hexa::RBJFilter<Type>> chain;
+				chain.prepare(Type(48000), nChans, blockSize);
+				setupStages(chain.template get<0>(), chain.template get<1>(), chain.template get<2>());
+
+				runner.run(name + " Chain", type, nChans, blockSize, [&]
+				{
+					chain.process(in.in(), out.out(), nChans, blockSize);
+				});
+			}
+		}
+	}
+
+	// A cutoff posted to a chained stage every block. Checked first: the LP output of the
+	// same noise has to drop once the change is through.
+	template <typename Type>
+	void benchPostedCutoff(hexa::bench::Runner& runner)
+	{
+		constexpr size_t blockSize = 512, nChans = 2;
+		const char* type = hexa::bench::typeName<Type>();
+
+		hexa::bench::PlanarBuffer<Type> in(nChans, blockSize), out(nChans, blockSize);
+		in.fillNoise();
+
+		hexa::Chain<hexa::OnePoleFilter<Type>, hexa::StateVariableFilter<Type>, hexa::RBJFilter<Type>> chain;
+		chain.prepare(Type(48000), nChans, blockSize);
+		setupStages(chain.template get<0>(), chain.template get<1>(), chain.template get<2>());
+
+		auto rms = [&]
+		{
+			chain.reset();
+			chain.process(in.in(), out.out(), nChans, blockSize);
+
+			double sum = 0;
+			for (size_t ch = 0; ch < nChans; ++ch)
+			{
+				for (size_t n = 0; n < blockSize; ++n) sum += double(out.out()[ch][n]) * double(out.out()[ch][n]);
+			}
+			return std::sqrt(sum / double(nChans * blockSize));
+		};
+
+		const double before = rms();
+		chain.template get<2>().postParameter(hexa::RBJFilterParameter::cutoff, Type(500));
+		const double after = rms();
+
+		const size_t numResults = runner.getResults().size();
+		bool low = false;
+		runner.run("HP>LS>LP postParameter(cutoff)", type, nChans, blockSize, [&]
+		{
+			low = !low;
+			chain.template get<2>().postParameter(hexa::RBJFilterParameter::cutoff, low ? Type(500) : Type(12000));
+			chain.process(in.in(), out.out(), nChans, blockSize);
+		});
+
+		if (runner.getResults().size() == numResults || runner.quiet) return;
+
+		std::printf("    LP cutoff 12000 -> 500 Hz posted to the Chain: rms %.3f -> %.3f, %s\n",
+			before, after, after < 0.5 * before ? "applied" : "NOT APPLIED");
+	}
+}
+
+HEXA_BENCH_SUITE(Chain)
+{
+	benchStrip<float, false>(runner, "HP>LS>LP");
+	benchStrip<float, true>(runner, "HP>LS>Clip>LP");
+	benchStrip<double, false>(runner, "HP>LS>LP");
+	benchStrip<double, true>(runner, "HP>LS>Clip>LP");
+	benchPostedCutoff<float>(runner);
+	benchPostedCutoff<double>(runner);
+}
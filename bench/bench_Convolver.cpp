@@ -0,0 +1,76 @@
+#include "hexa_Bench.h"
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <hexa/core/hexa_Convolver.h>
+
+namespace
+{
+	/** Exponentially decaying noise, like a reverb tail. */
+	template <typename Type>
+	std::vector<Type> makeImpulseResponse(size_t length)
+	{
+		std::mt19937 rng{ 7 };
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+		std::vector<Type> ir(length);
+		for (size_t n = 0; n < length; ++n) ir[n] = static_cast<Type>(dist(rng) * std::exp(-6.9 * double(n) / double(length)));
+		return ir;
+	}
+
+	template <typename Type>
+	void benchConvolver(hexa::bench::Runner& runner)
+	{
+		constexpr size_t blockSize = 512;
+		const char* type = hexa::bench::typeName<Type>();
+
+		{
+			hexa::FFT<Type> fft(2 * blockSize);
+			std::vector<Type> time(2 * blockSize), re(blockSize + 1), im(blockSize + 1);
+			for (size_t n = 0; n < time.size(); ++n) time[n] = static_cast<Type>(n % 7) - Type(3);
+
+			runner.run("FFT " + std::to_string(2 * blockSize) + " forward + inverse", type, 1, 2 * blockSize, [&]
+			{
+				fft.forward(time.data(), re.data(), im.data());
+				fft.inverse(re.data(), im.data(), time.data());
+				hexa::bench::doNotOptimize(time[0]);
+			});
+		}
+
+		for (double seconds : { 0.5, 5.0 })
+		{
+			const auto response = makeImpulseResponse<Type>(size_t(seconds * 48000));
+
+			for (size_t partitionSize : { 128, 256, 512 })
+			{
+				// One IR for all channels (and all Convolvers), built once.
+				const auto ir = hexa::ConvolutionIR<Type>::make(response.data(), response.size(), partitionSize);
+
+				for (size_t nChans : { 1, 8 })
+				{
+					hexa::bench::PlanarBuffer<Type> in(nChans, blockSize), out(nChans, blockSize);
+					in.fillNoise();
+
+					hexa::Convolver<Type> convolver;
+					convolver.setImpulseResponse(ir);
+					convolver.prepare(Type(48000), nChans, blockSize);
+
+					const std::string name = "Convolver " + std::to_string(seconds).substr(0, 3) + " s, partition " + std::to_string(partitionSize);
+					runner.run(name, type, nChans, blockSize, [&]
+					{
+						convolver.process(in.in(), out.out(), nChans, blockSize);
+					});
+				}
+			}
+		}
+	}
+}
+
+HEXA_BENCH_SUITE(Convolver)
+{
+	benchConvolver<float>(runner);
+	benchConvolver<double>(runner);
+}
@@ -0,0 +1,149 @@
+#include "hexa_Bench.h"
+
+#include <cmath>
+#include <vector>
+
+#include <hexa/core/hexa_DelayLine.h>
+
+namespace
+{
+	template <typename Type, hexa::InterpolationType interp>
+	void benchDelayLineBlocks(hexa::bench::Runner& runner, const std::string& name, double frac)
+	{
+		constexpr size_t blockSize = 512;
+		constexpr size_t delay = 48000;
+		const char* type = hexa::bench::typeName<Type>();
+
+		for (size_t nChans : { 1, 2 })
+		{
+			hexa::bench::PlanarBuffer<Type> io(nChans, blockSize);
+			io.fillNoise();
+
+			hexa::DelayLine<Type, interp> dl(static_cast<int>(delay + blockSize + 4), nChans);
+
+			runner.run(name + " push/operator()", type, nChans, blockSize, [&]
+			{
+				auto in = io.in();
+				auto out = io.out();
+				for (size_t ch = 0; ch < nChans; ++ch)
+				{
+					for (size_t n = 0; n < blockSize; ++n)
+					{
+						dl.push(ch, in[ch][n]);
+						out[ch][n] = dl(ch, delay, frac);
+					}
+				}
+			});
+
+			runner.run(name + " pushBlock/readBlock", type, nChans, blockSize, [&]
+			{
+				auto in = io.in();
+				auto out = io.out();
+				for (size_t ch = 0; ch < nChans; ++ch)
+				{
+					dl.pushBlock(ch, in[ch], blockSize);
+					dl.readBlock(ch, delay, out[ch], blockSize, frac);
+				}
+			});
+		}
+	}
+
+	template <typename Type, hexa::InterpolationType interp>
+	void benchDelayLineTaps(hexa::bench::Runner& runner, const std::string& name)
+	{
+		constexpr size_t blockSize = 512;
+		constexpr size_t numTaps = 16;
+		const char* type = hexa::bench::typeName<Type>();
+
+		hexa::bench::PlanarBuffer<Type> io(1, blockSize);
+		io.fillNoise();
+
+		hexa::DelayLine<Type, interp> dl(4096, 1);
+
+		// Chorus-like voices: slowly modulated fractional delays.
+		std::vector<Type> delays(numTaps), mod(blockSize), taps(numTaps);
+		for (size_t t = 0; t < numTaps; ++t) delays[t] = Type(200 + 97.3 * double(t));
+		for (size_t n = 0; n < blockSize; ++n) mod[n] = Type(400 + 150 * std::sin(0.01 * double(n)));
+
+		runner.run(name + " taps x16 operator()", type, 1, blockSize, [&]
+		{
+			const Type* in = io.in()[0];
+			Type* out = io.out()[0];
+			for (size_t n = 0; n < blockSize; ++n)
+			{
+				dl.push(0, in[n]);
+
+				Type sum = 0;
+				for (size_t t = 0; t < numTaps; ++t)
+				{
+					const Type d = delays[t] + Type(0.001) * Type(n);
+					const auto del = static_cast<size_t>(d);
+					sum += dl(0, del, d - static_cast<Type>(del));
+				}
+				out[n] = sum;
+			}
+		});
+
+		runner.run(name + " taps x16 readTaps", type, 1, blockSize, [&]
+		{
+			const Type* in = io.in()[0];
+			Type* out = io.out()[0];
+			for (size_t n = 0; n < blockSize; ++n)
+			{
+				dl.push(0, in[n]);
+
+				for (size_t t = 0; t < numTaps; ++t) taps[t] = delays[t] + Type(0.001) * Type(n);
+				dl.readTaps(0, taps.data(), taps.data(), numTaps);
+
+				Type sum = 0;
+				for (size_t t = 0; t < numTaps; ++t) sum += taps[t];
+				out[n] = sum;
+			}
+		});
+
+		runner.run(name + " modulated operator()", type, 1, blockSize, [&]
+		{
+			const Type* in = io.in()[0];
+			Type* out = io.out()[0];
+			for (size_t n = 0; n < blockSize; ++n)
+			{
+				dl.push(0, in[n]);
+				const auto del = static_cast<size_t>(mod[n]);
+				out[n] = dl(0, del, mod[n] - static_cast<Type>(del));
+			}
+		});
+
+		runner.run(name + " modulated readModulated", type, 1, blockSize, [&]
+		{
+			dl.pushBlock(0, io.in()[0], blockSize);
+			dl.readModulated(0, mod.data(), io.out()[0], blockSize);
+		});
+	}
+
+	template <typename Type>
+	void benchDelayLine(hexa::bench::Runner& runner)
+	{
+		benchDelayLineBlocks<Type, hexa::InterpolationType::Drop>(runner, "DelayLine Drop", 0);
+		benchDelayLineBlocks<Type, hexa::InterpolationType::Linear>(runner, "DelayLine Linear", 0.3);
+		benchDelayLineBlocks<Type, hexa::InterpolationType::CatmullRom>(runner, "DelayLine CatmullRom", 0.3);
+
+		benchDelayLineTaps<Type, hexa::InterpolationType::Linear>(runner, "DelayLine Linear");
+		benchDelayLineTaps<Type, hexa::InterpolationType::CatmullRom>(runner, "DelayLine CatmullRom");
+		benchDelayLineTaps<Type, hexa::InterpolationType::Opti4>(runner, "DelayLine Opti4");
+
+		// Divide by the taps for the cost per tap.
+		benchDelayLineBlocks<Type, hexa::InterpolationType::Sinc8>(runner, "DelayLine Sinc8", 0.3);
+		benchDelayLineBlocks<Type, hexa::InterpolationType::Sinc32>(runner, "DelayLine Sinc32", 0.3);
+		benchDelayLineBlocks<Type, hexa::InterpolationType::Sinc64>(runner, "DelayLine Sinc64", 0.3);
+
+		benchDelayLineTaps<Type, hexa::InterpolationType::Sinc8>(runner, "DelayLine Sinc8");
+		benchDelayLineTaps<Type, hexa::InterpolationType::Sinc32>(runner, "DelayLine Sinc32");
+		benchDelayLineTaps<Type, hexa::InterpolationType::Sinc64>(runner, "DelayLine Sinc64");
+	}
+}
+
+HEXA_BENCH_SUITE(DelayLine)
+{
+	benchDelayLine<float>(runner);
+	benchDelayLine<double>(runner);
+}
@@ -0,0 +1,115 @@
+#include "hexa_Bench.h"
+
+#include <hexa/filters/hexa_ActiveOnePoleFilter.h>
+#include <hexa/filters/hexa_BiquadCascade.h>
+#include <hexa/filters/hexa_OnePoleFilter.h>
+#include <hexa/filters/hexa_RBJFilter.h>
+#include <hexa/filters/hexa_SallenKeyFilter.h>
+#include <hexa/filters/hexa_StateVariableFilter.h>
+#include <hexa/filters/hexa_SymDiodeClipper.h>
+
+#include <limits>
+
+namespace
+{
+	constexpr size_t blockSize = 256;
+	constexpr size_t numBlocks = 8;
+	constexpr size_t nChans = 2;
+
+	struct Mode
+	{
+		hexa::DenormalMode mode;
+		const char* name;
+	};
+
+	constexpr Mode modes[] = {
+		{ hexa::DenormalMode::none, "none" },
+		{ hexa::DenormalMode::ftz, "ftz" },
+		{ hexa::DenormalMode::flush, "flush" },
+		{ hexa::DenormalMode::offset, "offset" } };
+
+	/**
+	 * An idle channel after a signal stopped: the first block holds a tiny impulse (the end
+	 * of the signal), the next numBlocks - 1 blocks are silent, so the states decay through
+	 * the denormal range. The active case runs the same blocks with full scale noise.
+	 */
+	template <typename Type, typename Processor>
+	void benchIdle(hexa::bench::Runner& runner, const std::string& name, Processor& proc)
+	{
+		const char* type = hexa::bench::typeName<Type>();
+
+		hexa::bench::PlanarBuffer<Type> tail(nChans, blockSize), silence(nChans, blockSize), noise(nChans, blockSize), out(nChans, blockSize);
+		noise.fillNoise();
+		for (size_t ch = 0; ch < nChans; ++ch) tail.out()[ch][0] = std::numeric_limits<Type>::min() * Type(1000);
+
+		for (const auto& m : modes)
+		{
+			proc.prepare(Type(48000), nChans, blockSize);
+			proc.setDenormalMode(m.mode);
+
+			runner.run(name + " idle " + m.name, type, nChans, blockSize * numBlocks, [&]
+			{
+				proc.process(tail.in(), out.out(), nChans, blockSize);
+				for (size_t b = 1; b < numBlocks; ++b) proc.process(silence.in(), out.out(), nChans, blockSize);
+			});
+		}
+
+		proc.prepare(Type(48000), nChans, blockSize);
+		proc.setDenormalMode(hexa::DenormalMode::none);
+
+		runner.run(name + " active", type, nChans, blockSize * numBlocks, [&]
+		{
+			for (size_t b = 0; b < numBlocks; ++b) proc.process(noise.in(), out.out(), nChans, blockSize);
+		});
+	}
+
+	template <typename Type>
+	void benchDenormals(hexa::bench::Runner& runner)
+	{
+		{
+			hexa::OnePoleFilter<Type> filter;
+			filter.setCutoff(Type(200));
+			benchIdle<Type>(runner, "OnePole LP", filter);
+		}
+		{
+			hexa::StateVariableFilter<Type> filter;
+			filter.setCutoff(Type(200));
+			filter.setQ(Type(2));
+			benchIdle<Type>(runner, "StateVariable LP", filter);
+		}
+		{
+			hexa::RBJFilter<Type> filter;
+			filter.setCutoff(Type(200));
+			filter.setQ(Type(2));
+			benchIdle<Type>(runner, "RBJ LP", filter);
+		}
+		{
+			hexa::SallenKeyFilter<Type> filter;
+			filter.setFrequency(Type(200));
+			filter.setResonance(Type(0.5));
+			benchIdle<Type>(runner, "SallenKey LP", filter);
+		}
+		{
+			hexa::BiquadCascade<Type, 4> filter;
+			for (size_t i = 0; i < 4; ++i) filter.setSection(i, hexa::RBJFilterType::LP, Type(200 * (i + 1)), Type(0.7), Type(0));
+			benchIdle<Type>(runner, "BiquadCascade<4> LP", filter);
+		}
+		{
+			hexa::ActiveOnePoleFilter<Type> filter;
+			filter.setFrequency(Type(200));
+			benchIdle<Type>(runner, "ActiveOnePole", filter);
+		}
+		{
+			hexa::SymDiodeClipper<Type> clipper;
+			clipper.setFrequency(Type(2000));
+			clipper.setGain(Type(20));
+			benchIdle<Type>(runner, "SymDiodeClipper", clipper);
+		}
+	}
+}
+
+HEXA_BENCH_SUITE(Denormals)
+{
+	benchDenormals<float>(runner);
+	benchDenormals<double>(runner);
+}
@@ -0,0 +1,66 @@
+#include "hexa_Bench.h"
+
+#include <ratio>
+#include <string>
+
+#include <hexa/filters/hexa_RBJFilter.h>
+#include <hexa/filters/hexa_StateVariableFilter.h>
+
+namespace
+{
+	template <typename Runtime, typename Fixed, typename Type, typename SetupFn>
+	void benchFixed(hexa::bench::Runner& runner, const std::string& name, SetupFn&& setup)
+	{
+		constexpr size_t blockSize = 512;
+		const char* type = hexa::bench::typeName<Type>();
+
+		for (size_t nChans : { 1, 2, 8 })
+		{
+			hexa::bench::PlanarBuffer<Type> in(nChans, blockSize), out(nChans, blockSize);
+			in.fillNoise();
+
+			Runtime runtime;
+			runtime.prepare(Type(48000), nChans, blockSize);
+			setup(runtime);
+
+			Fixed fixed;
+			fixed.prepare(Type(48000), nChans, blockSize);
+
+			runner.run(name + " runtime", type, nChans, blockSize, [&]
+			{
+				runtime.process(in.in(), out.out(), nChans, blockSize);
+			});
+
+			runner.run(name + " fixed", type, nChans, blockSize, [&]
+			{
+				fixed.process(in.in(), out.out(), nChans, blockSize);
+			});
+		}
+	}
+
+	template <typename Type>
+	void benchFixedFilters(hexa::bench::Runner& runner)
+	{
+		using DCBlocker = hexa::FixedRBJFilter<Type, hexa::RBJFilterType::HP, 10, std::ratio<1, 2>, 48000>;
+		benchFixed<hexa::RBJFilter<Type>, DCBlocker, Type>(runner, "RBJFilter HP 10 Hz", [](auto& f)
+		{
+			f.setType(hexa::RBJFilterType::HP);
+			f.setCutoff(Type(10));
+			f.setQ(Type(0.5));
+		});
+
+		using Crossover = hexa::FixedStateVariableFilter<Type, hexa::StateVariableType::LP, 2000, std::ratio<7071, 10000>, 48000>;
+		benchFixed<hexa::StateVariableFilter<Type>, Crossover, Type>(runner, "StateVariableFilter LP 2 kHz", [](auto& f)
+		{
+			f.setType(hexa::StateVariableType::LP);
+			f.setCutoff(Type(2000));
+			f.setQ(Type(0.7071));
+		});
+	}
+}
+
+HEXA_BENCH_SUITE(FixedFilters)
+{
+	benchFixedFilters<float>(runner);
+	benchFixedFilters<double>(runner);
+}
@@ -0,0 +1,112 @@
+#include "hexa_Bench.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <hexa/filters/hexa_OnePoleFilter.h>
+#include <hexa/filters/hexa_RBJFilter.h>
+#include <hexa/filters/hexa_SallenKeyFilter.h>
+#include <hexa/filters/hexa_StateVariableFilter.h>
+
+namespace
+{
+	constexpr size_t numBands = 32;
+	constexpr size_t numBins = 2048;
+
+	/** A UI curve: numBands filters evaluated on the same log spaced frequencies. */
+	template <typename Type, typename Filter, typename SetupFn>
+	void benchCurves(hexa::bench::Runner& runner, const char* name, const std::vector<Type>& freqs, SetupFn&& setup)
+	{
+		const char* type = hexa::bench::typeName<Type>();
+
+		std::vector<Filter> bands(numBands);
+		for (size_t b = 0; b < numBands; ++b)
+		{
+			bands[b].prepare(Type(48000), 1, 64);
+			setup(bands[b], Type(30) * std::pow(Type(500), Type(b) / Type(numBands)));
+		}
+
+		std::vector<Type> out(numBins);
+
+		runner.run(std::string(name) + " magnitude", type, numBands, numBins, [&]
+		{
+			for (auto&& band : bands) band.getMagnitudeResponse(freqs.data(), out.data(), numBins);
+			hexa::bench::doNotOptimize(out[0]);
+		});
+
+		runner.run(std::string(name) + " phase", type, numBands, numBins, [&]
+		{
+			for (auto&& band : bands) band.getPhaseResponse(freqs.data(), out.data(), numBins);
+			hexa::bench::doNotOptimize(out[0]);
+		});
+	}
+
+	template <typename Type>
+	void benchFrequencyResponse(hexa::bench::Runner& runner)
+	{
+		const char* type = hexa::bench::typeName<Type>();
+
+		std::vector<Type> freqs(numBins);
+		for (size_t k = 0; k < numBins; ++k) freqs[k] = Type(20) * std::pow(Type(1000), Type(k) / Type(numBins - 1));
+
+		benchCurves<Type, hexa::RBJFilter<Type>>(runner, "RBJFilter peak", freqs, [](auto& f, Type cutoff)
+		{
+			f.setType(hexa::RBJFilterType::peak);
+			f.setCutoff(cutoff);
+			f.setQ(Type(2));
+		});
+
+		benchCurves<Type, hexa::StateVariableFilter<Type>>(runner, "StateVariableFilter BS", freqs, [](auto& f, Type cutoff)
+		{
+			f.setType(hexa::StateVariableType::BS);
+			f.setCutoff(cutoff);
+			f.setQ(Type(2));
+		});
+
+		benchCurves<Type, hexa::OnePoleFilter<Type>>(runner, "OnePoleFilter HS", freqs, [](auto& f, Type cutoff)
+		{
+			f.setType(hexa::OnePoleType::HS);
+			f.setCutoff(cutoff);
+		});
+
+		benchCurves<Type, hexa::SallenKeyFilter<Type>>(runner, "SallenKeyFilter LP", freqs, [](auto& f, Type cutoff)
+		{
+			f.setType(hexa::SallenKeyFilterType::LP);
+			f.setFrequency(cutoff);
+		});
+
+		// What a UI does without the above: scalar std::complex evaluation of the same bi-quads.
+		std::vector<hexa::BiquadCoefficients<Type>> coeffs(numBands);
+		for (size_t b = 0; b < numBands; ++b)
+		{
+			hexa::RBJFilter<Type> f;
+			f.prepare(Type(48000), 1, 64);
+			f.setType(hexa::RBJFilterType::peak);
+			f.setCutoff(Type(30) * std::pow(Type(500), Type(b) / Type(numBands)));
+			f.setQ(Type(2));
+			coeffs[b] = f.getTransferFunction();
+		}
+
+		std::vector<Type> mags(numBins);
+		runner.run("std::complex magnitude (reference)", type, numBands, numBins, [&]
+		{
+			for (auto&& h : coeffs)
+			{
+				for (size_t k = 0; k < numBins; ++k)
+				{
+					const auto z1 = std::polar(Type(1), -hexa::c<Type>::twoPi * freqs[k] / Type(48000));
+					const auto z2 = z1 * z1;
+					mags[k] = std::abs((h.b0 + h.b1 * z1 + h.b2 * z2) / (Type(1) + h.a1 * z1 + h.a2 * z2));
+				}
+			}
+			hexa::bench::doNotOptimize(mags[0]);
+		});
+	}
+}
+
+HEXA_BENCH_SUITE(FrequencyResponse)
+{
+	benchFrequencyResponse<float>(runner);
+	benchFrequencyResponse<double>(runner);
+}
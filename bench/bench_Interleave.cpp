@@ -0,0 +1,78 @@
+#include "hexa_Bench.h"
+
+#include <vector>
+
+#include <hexa/core/hexa_Interleave.h>
+#include <hexa/filters/hexa_RBJFilter.h>
+
+namespace
+{
+	template <typename Type>
+	void benchInterleave(hexa::bench::Runner& runner)
+	{
+		constexpr size_t blockSize = 512;
+		const char* type = hexa::bench::typeName<Type>();
+
+		for (size_t nChans : { 2, 4, 6, 8 })
+		{
+			hexa::bench::PlanarBuffer<Type> io(nChans, blockSize);
+			io.fillNoise();
+			std::vector<Type> frames(nChans * blockSize);
+
+			runner.run("naive interleave", type, nChans, blockSize, [&]
+			{
+				const Type** in = io.in();
+				for (size_t n = 0; n < blockSize; ++n)
+				{
+					for (size_t ch = 0; ch < nChans; ++ch) frames[n * nChans + ch] = in[ch][n];
+				}
+				hexa::bench::doNotOptimize(frames[0]);
+			});
+
+			runner.run("interleave", type, nChans, blockSize, [&]
+			{
+				hexa::interleave(io.in(), frames.data(), nChans, blockSize);
+				hexa::bench::doNotOptimize(frames[0]);
+			});
+
+			runner.run("naive deinterleave", type, nChans, blockSize, [&]
+			{
+				Type** out = io.out();
+				for (size_t n = 0; n < blockSize; ++n)
+				{
+					for (size_t ch = 0; ch < nChans; ++ch) out[ch][n] = frames[n * nChans + ch];
+				}
+			});
+
+			runner.run("deinterleave", type, nChans, blockSize, [&]
+			{
+				hexa::deinterleave(frames.data(), io.out(), nChans, blockSize);
+			});
+		}
+
+		// The most common I/O case: a stereo filter fed by interleaved frames.
+		hexa::bench::PlanarBuffer<Type> io(2, blockSize);
+		std::vector<Type> in(2 * blockSize, Type(0.5)), out(2 * blockSize);
+
+		hexa::RBJFilter<Type> filter;
+		filter.prepare(Type(48000), 2, blockSize);
+
+		runner.run("RBJ stereo deinterleave+process+interleave", type, 2, blockSize, [&]
+		{
+			hexa::deinterleave(in.data(), io.out(), 2, blockSize);
+			filter.process(io.in(), io.out(), 2, blockSize);
+			hexa::interleave(io.in(), out.data(), 2, blockSize);
+		});
+
+		runner.run("RBJ processInterleavedStereo", type, 2, blockSize, [&]
+		{
+			filter.processInterleavedStereo(in.data(), out.data(), blockSize);
+		});
+	}
+}
+
+HEXA_BENCH_SUITE(Interleave)
+{
+	benchInterleave<float>(runner);
+	benchInterleave<double>(runner);
+}
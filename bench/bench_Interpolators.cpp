@@ -0,0 +1,82 @@
+#include "hexa_Bench.h"
+
+#include <string>
+#include <vector>
+
+#include <hexa/core/hexa_Simd.h>
+#include <hexa/math/hexa_Interpolators.h>
+
+namespace
+{
+	// Every evaluation reads its own fraction and points, as a modulated delay read does
+	// after the gather.
+	template <typename Type, hexa::InterpolationType interp>
+	void benchInterpolator(hexa::bench::Runner& runner, const std::string& name)
+	{
+		using Interp = hexa::Interpolator<Type, interp>;
+		using Batch = hexa::simd::Batch<Type>;
+		constexpr size_t numPoints = Interp::numPoints;
+		constexpr size_t blockSize = 4096;
+		const char* type = hexa::bench::typeName<Type>();
+
+		hexa::bench::PlanarBuffer<Type> pts(numPoints + 1, blockSize), out(1, blockSize);
+		pts.fillNoise();
+
+		// Channel numPoints holds the fractions, moved to [0, 1).
+		Type* x = pts.out()[numPoints];
+		for (size_t n = 0; n < blockSize; ++n) x[n] = x[n] * Type(0.5) + Type(0.5);
+
+		const Type* const* y = pts.in();
+		Type* dst = out.out()[0];
+
+		runner.run(name + " operator()", type, 1, blockSize, [&]
+		{
+			const Interp op{};
+			for (size_t n = 0; n < blockSize; ++n)
+			{
+				if constexpr (numPoints == 1) dst[n] = op(x[n], y[0][n]);
+				else if constexpr (numPoints == 2) dst[n] = op(x[n], y[0][n], y[1][n]);
+				else dst[n] = op(x[n], y[0][n], y[1][n], y[2][n], y[3][n]);
+			}
+		});
+
+		runner.run(name + " eval<Batch>", type, 1, blockSize, [&]
+		{
+			for (size_t n = 0; n < blockSize; n += Batch::size)
+			{
+				auto ld = [&](const Type* p) { return Batch::load(p + n); };
+
+				if constexpr (numPoints == 1) Interp::eval(ld(x), ld(y[0])).store(dst + n);
+				else if constexpr (numPoints == 2) Interp::eval(ld(x), ld(y[0]), ld(y[1])).store(dst + n);
+				else Interp::eval(ld(x), ld(y[0]), ld(y[1]), ld(y[2]), ld(y[3])).store(dst + n);
+			}
+		});
+
+		runner.run(name + " evaluate()", type, 1, blockSize, [&]
+		{
+			if constexpr (numPoints == 1) Interp::evaluate(x, y[0], dst, blockSize);
+			else if constexpr (numPoints == 2) Interp::evaluate(x, y[0], y[1], dst, blockSize);
+			else Interp::evaluate(x, y[0], y[1], y[2], y[3], dst, blockSize);
+		});
+	}
+
+	template <typename Type>
+	void benchInterpolators(hexa::bench::Runner& runner)
+	{
+		using IT = hexa::InterpolationType;
+
+		benchInterpolator<Type, IT::Drop>(runner, "Drop");
+		benchInterpolator<Type, IT::Linear>(runner, "Linear");
+		benchInterpolator<Type, IT::Lagrange3>(runner, "Lagrange3");
+		benchInterpolator<Type, IT::BSpline3>(runner, "BSpline3");
+		benchInterpolator<Type, IT::CatmullRom>(runner, "CatmullRom");
+		benchInterpolator<Type, IT::Opti3>(runner, "Opti3");
+		benchInterpolator<Type, IT::Opti4>(runner, "Opti4");
+	}
+}
+
+HEXA_BENCH_SUITE(Interpolators)
+{
+	benchInterpolators<float>(runner);
+	benchInterpolators<double>(runner);
+}
@@ -0,0 +1,45 @@
+#include "hexa_Bench.h"
+
+#include <hexa/core/hexa_Oversampler.h>
+
+namespace
+{
+	/** Leaves the oversampled signal untouched, so only the resampling is timed. */
+	template <typename Type>
+	struct Bypass
+	{
+		void prepare(Type, size_t, size_t) noexcept {}
+		void process(const Type**, Type**, size_t, size_t) noexcept {}
+		void reset() noexcept {}
+	};
+
+	template <typename Type, hexa::OversamplingType osType>
+	void benchOversampler(hexa::bench::Runner& runner, const char* name)
+	{
+		constexpr size_t blockSize = 512;
+		constexpr size_t nChans = 2;
+
+		for (size_t numStages = 1; numStages <= 4; ++numStages)
+		{
+			hexa::bench::PlanarBuffer<Type> io(nChans, blockSize);
+			io.fillNoise();
+
+			hexa::Oversampled<Type, Bypass<Type>, osType> os(numStages);
+			os.prepare(Type(48000), nChans, blockSize);
+
+			runner.run(std::string(name) + " " + std::to_string(os.getFactor()) + "x up+down", hexa::bench::typeName<Type>(),
+				nChans, blockSize, [&]
+			{
+				os.process(io.in(), io.out(), nChans, blockSize);
+			});
+		}
+	}
+}
+
+HEXA_BENCH_SUITE(Oversampler)
+{
+	benchOversampler<float, hexa::OversamplingType::FIR>(runner, "FIR");
+	benchOversampler<float, hexa::OversamplingType::IIR>(runner, "IIR");
+	benchOversampler<double, hexa::OversamplingType::FIR>(runner, "FIR");
+	benchOversampler<double, hexa::OversamplingType::IIR>(runner, "IIR");
+}
@@ -0,0 +1,68 @@
+#include "hexa_Bench.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <hexa/core/hexa_ParallelProcessor.h>
+#include <hexa/filters/hexa_StateVariableFilter.h>
+#include <hexa/filters/hexa_SymDiodeClipper.h>
+
+namespace
+{
+	// Thread counts 1, 2, 4, ... up to the hardware concurrency (which is always included).
+	std::vector<size_t> threadCounts()
+	{
+		const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+		std::vector<size_t> counts;
+		for (size_t n = 1; n < maxThreads; n *= 2) counts.push_back(n);
+		counts.push_back(maxThreads);
+		return counts;
+	}
+
+	template <typename Proc, typename Type, typename SetupFn>
+	void benchScaling(hexa::bench::Runner& runner, const std::string& name, SetupFn&& setup)
+	{
+		constexpr size_t nChans = 256;
+		constexpr size_t blockSize = 512;
+
+		hexa::bench::PlanarBuffer<Type> in(nChans, blockSize), out(nChans, blockSize);
+		in.fillNoise();
+
+		double singleThreaded = 0;
+		for (size_t numThreads : threadCounts())
+		{
+			hexa::ThreadPool pool(numThreads);
+			hexa::ParallelProcessor<Proc> bank(pool);
+			bank.prepare(Type(48000), nChans, blockSize);
+			bank.forEach(setup);
+
+			const size_t numResults = runner.getResults().size();
+			runner.run(name + " threads=" + std::to_string(numThreads), hexa::bench::typeName<Type>(), nChans, blockSize, [&]
+			{
+				bank.process(in.in(), out.out(), nChans, blockSize);
+			});
+
+			// Skipped by --filter (or JSON only): nothing to report.
+			if (runner.getResults().size() == numResults || runner.quiet) continue;
+
+			// Efficiency: speed-up over one thread divided by the number of threads, only
+			// with the single-threaded case measured as well.
+			const double ns = runner.getResults().back().nsPerSample;
+			if (numThreads == 1) singleThreaded = ns;
+			if (singleThreaded == 0) continue;
+
+			std::printf("    %zu tasks of %zu channels, scaling efficiency %.0f%%\n",
+				bank.getNumTasks(), bank.getChannelsPerTask(), 100. * singleThreaded / (ns * double(numThreads)));
+		}
+	}
+}
+
+HEXA_BENCH_SUITE(ParallelProcessor)
+{
+	benchScaling<hexa::StateVariableFilter<float>, float>(runner, "StateVariableFilter", [](auto& f) { f.setCutoff(800.f); });
+	benchScaling<hexa::SymDiodeClipper<float>, float>(runner, "SymDiodeClipper", [](auto& f) { f.setGain(12.f); });
+	benchScaling<hexa::StateVariableFilter<double>, double>(runner, "StateVariableFilter", [](auto& f) { f.setCutoff(800.); });
+}
@@ -0,0 +1,84 @@
+#include "hexa_Bench.h"
+
+#include <string>
+
+#include <hexa/filters/hexa_ActiveOnePoleFilter.h>
+#include <hexa/filters/hexa_BiquadCascade.h>
+#include <hexa/filters/hexa_OnePoleFilter.h>
+#include <hexa/filters/hexa_RBJFilter.h>
+#include <hexa/filters/hexa_SallenKeyFilter.h>
+#include <hexa/filters/hexa_StateVariableFilter.h>
+#include <hexa/filters/hexa_SymDiodeClipper.h>
+
+// Cost of the parameter paths (setter plus coefficient update). A "block" is one sweep of
+// numCalls distinct values, so the ns/sample column reads as ns per call.
+
+namespace
+{
+	constexpr size_t numCalls = 256;
+
+	template <typename Proc, typename Type, typename SetFn>
+	void benchSetter(hexa::bench::Runner& runner, const std::string& name, Proc& proc, Type first, Type last, SetFn&& set)
+	{
+		Type values[numCalls];
+		for (size_t i = 0; i < numCalls; ++i) values[i] = first + (last - first) * Type(i) / Type(numCalls - 1);
+
+		proc.prepare(Type(48000), 2, 512);
+
+		runner.run(name, hexa::bench::typeName<Type>(), 1, numCalls, [&]
+		{
+			for (Type v : values)
+			{
+				set(proc, v);
+				hexa::bench::doNotOptimize(proc);
+			}
+		});
+	}
+
+	template <typename Type>
+	void benchParameters(hexa::bench::Runner& runner)
+	{
+		hexa::OnePoleFilter<Type> onePole;
+		benchSetter(runner, "OnePoleFilter setCutoff", onePole, Type(100), Type(10000), [](auto& f, Type v) { f.setCutoff(v); });
+
+		hexa::StateVariableFilter<Type> svf;
+		benchSetter(runner, "StateVariableFilter setCutoff", svf, Type(100), Type(10000), [](auto& f, Type v) { f.setCutoff(v); });
+		benchSetter(runner, "StateVariableFilter setQ", svf, Type(0.5), Type(8), [](auto& f, Type v) { f.setQ(v); });
+		benchSetter(runner, "StateVariableFilter setBandWidth", svf, Type(0.2), Type(2), [](auto& f, Type v) { f.setBandWidth(v); });
+
+		hexa::RBJFilter<Type> rbj;
+		rbj.setType(hexa::RBJFilterType::peak);
+		benchSetter(runner, "RBJFilter setCutoff", rbj, Type(100), Type(10000), [](auto& f, Type v) { f.setCutoff(v); });
+		benchSetter(runner, "RBJFilter setGain", rbj, Type(-12), Type(12), [](auto& f, Type v) { f.setGain(v); });
+
+		// Queued from a control thread: 16 cutoff changes coalesced into one update by the
+		// next process() (an empty block here, so only the drain is timed).
+		runner.run("RBJFilter postParameter x16 + drain", hexa::bench::typeName<Type>(), 1, 16, [&]
+		{
+			for (size_t i = 0; i < 16; ++i) rbj.postParameter(hexa::RBJFilterParameter::cutoff, Type(1000 + 10 * i));
+			rbj.process(nullptr, nullptr, 0, 0);
+		});
+
+		hexa::BiquadCascade<Type, 8> cascade;
+		benchSetter(runner, "BiquadCascade setCutoff", cascade, Type(100), Type(10000), [](auto& f, Type v) { f.setCutoff(3, v); });
+
+		hexa::SallenKeyFilter<Type> sallenKey;
+		benchSetter(runner, "SallenKeyFilter setFrequency", sallenKey, Type(100), Type(10000), [](auto& f, Type v) { f.setFrequency(v); });
+
+		hexa::ActiveOnePoleFilter<Type> activeOnePole;
+		benchSetter(runner, "ActiveOnePoleFilter setFrequency", activeOnePole, Type(100), Type(10000), [](auto& f, Type v) { f.setFrequency(v); });
+
+		hexa::SymDiodeClipper<Type> clipper;
+		benchSetter(runner, "SymDiodeClipper setFrequency", clipper, Type(100), Type(10000), [](auto& f, Type v) { f.setFrequency(v); });
+
+		// In Table mode every update rebuilds the table, so this one is far off the others.
+		clipper.setSolver(hexa::DiodeClipperSolver::Table);
+		benchSetter(runner, "SymDiodeClipper(Table) setFrequency", clipper, Type(100), Type(10000), [](auto& f, Type v) { f.setFrequency(v); });
+	}
+}
+
+HEXA_BENCH_SUITE(Parameters)
+{
+	benchParameters<float>(runner);
+	benchParameters<double>(runner);
+}
@@ -0,0 +1,50 @@
+#include "hexa_Bench.h"
+
+#include <vector>
+
+#include <hexa/filters/hexa_Prewarpers.h>
+
+namespace
+{
+	template <typename Type, typename Prewarper>
+	void benchPrewarper(hexa::bench::Runner& runner, const std::string& name)
+	{
+		constexpr size_t numFreqs = 4096;
+		const char* type = hexa::bench::typeName<Type>();
+
+		std::vector<Type> freqs(numFreqs), gs(numFreqs);
+		for (size_t i = 0; i < numFreqs; ++i) freqs[i] = Type(20) + Type(19980) * Type(i) / Type(numFreqs);
+
+		Prewarper pw;
+		pw.setup(Type(48000));
+
+		runner.run(name + " g()", type, 1, numFreqs, [&]
+		{
+			for (size_t i = 0; i < numFreqs; ++i) gs[i] = pw.g(freqs[i]);
+			hexa::bench::doNotOptimize(gs[numFreqs - 1]);
+		});
+
+		runner.run(name + " g(batch)", type, 1, numFreqs, [&]
+		{
+			pw.g(freqs.data(), gs.data(), numFreqs);
+			hexa::bench::doNotOptimize(gs[numFreqs - 1]);
+		});
+	}
+
+	template <typename Type>
+	void benchPrewarpers(hexa::bench::Runner& runner)
+	{
+		benchPrewarper<Type, hexa::SimplePrewarper<Type>>(runner, "Simple");
+		benchPrewarper<Type, hexa::TaylorPrewarper<Type>>(runner, "Taylor");
+		benchPrewarper<Type, hexa::PadePrewarper<Type>>(runner, "Pade[5/4]");
+		benchPrewarper<Type, hexa::PadePrewarper<Type, true>>(runner, "Pade[3/4]");
+		benchPrewarper<Type, hexa::MinimaxPrewarper<Type>>(runner, "Minimax");
+		benchPrewarper<Type, hexa::TablePrewarper<Type>>(runner, "Table");
+	}
+}
+
+HEXA_BENCH_SUITE(Prewarpers)
+{
+	benchPrewarpers<float>(runner);
+	benchPrewarpers<double>(runner);
+}
@@ -0,0 +1,141 @@
+#include "hexa_Bench.h"
+
+#include <string>
+
+#include <hexa/core/hexa_DelayLine.h>
+#include <hexa/filters/hexa_ActiveOnePoleFilter.h>
+#include <hexa/filters/hexa_BiquadCascade.h>
+#include <hexa/filters/hexa_OnePoleFilter.h>
+#include <hexa/filters/hexa_RBJFilter.h>
+#include <hexa/filters/hexa_SallenKeyFilter.h>
+#include <hexa/filters/hexa_StateVariableFilter.h>
+#include <hexa/filters/hexa_SymDiodeClipper.h>
+
+// The same grid for every processor: both sample types, 1 to 64 channels and blocks of 16
+// to 4096 frames. Narrow a run with --filter, e.g. "Processors/RBJFilter".
+
+namespace
+{
+	constexpr size_t channelCounts[] = { 1, 2, 8, 64 };
+	constexpr size_t blockSizes[] = { 16, 64, 256, 1024, 4096 };
+
+	template <typename Proc, typename Type, typename SetupFn>
+	void benchGrid(hexa::bench::Runner& runner, const std::string& name, SetupFn&& setup)
+	{
+		for (size_t nChans : channelCounts)
+		{
+			for (size_t blockSize : blockSizes)
+			{
+				// Separate input and output, so a filter never runs on its own decaying output.
+				hexa::bench::PlanarBuffer<Type> in(nChans, blockSize), out(nChans, blockSize);
+				in.fillNoise();
+
+				Proc proc;
+				proc.prepare(Type(48000), nChans, blockSize);
+				setup(proc);
+
+				runner.run(name, hexa::bench::typeName<Type>(), nChans, blockSize, [&]
+				{
+					proc.process(in.in(), out.out(), nChans, blockSize);
+				});
+			}
+		}
+	}
+
+	template <typename Type>
+	void benchDelayGrid(hexa::bench::Runner& runner)
+	{
+		constexpr size_t delay = 1000;
+
+		for (size_t nChans : channelCounts)
+		{
+			for (size_t blockSize : blockSizes)
+			{
+				hexa::bench::PlanarBuffer<Type> in(nChans, blockSize), out(nChans, blockSize);
+				in.fillNoise();
+
+				hexa::DelayLine<Type, hexa::InterpolationType::CatmullRom> dl(static_cast<int>(delay + blockSize + 4), nChans);
+
+				runner.run("DelayLine push/operator()", hexa::bench::typeName<Type>(), nChans, blockSize, [&]
+				{
+					auto src = in.in();
+					auto dst = out.out();
+					for (size_t ch = 0; ch < nChans; ++ch)
+					{
+						for (size_t n = 0; n < blockSize; ++n)
+						{
+							dl.push(ch, src[ch][n]);
+							dst[ch][n] = dl(ch, delay, 0.3);
+						}
+					}
+				});
+
+				runner.run("DelayLine pushBlock/readBlock", hexa::bench::typeName<Type>(), nChans, blockSize, [&]
+				{
+					auto src = in.in();
+					auto dst = out.out();
+					for (size_t ch = 0; ch < nChans; ++ch)
+					{
+						dl.pushBlock(ch, src[ch], blockSize);
+						dl.readBlock(ch, delay, dst[ch], blockSize, 0.3);
+					}
+				});
+			}
+		}
+	}
+
+	template <typename Type>
+	void benchProcessors(hexa::bench::Runner& runner)
+	{
+		benchGrid<hexa::OnePoleFilter<Type>, Type>(runner, "OnePoleFilter", [](auto& f)
+		{
+			f.setType(hexa::OnePoleType::LP);
+			f.setCutoff(Type(1000));
+		});
+
+		benchGrid<hexa::StateVariableFilter<Type>, Type>(runner, "StateVariableFilter", [](auto& f)
+		{
+			f.setType(hexa::StateVariableType::LP);
+			f.setCutoff(Type(1000));
+		});
+
+		benchGrid<hexa::RBJFilter<Type>, Type>(runner, "RBJFilter", [](auto& f)
+		{
+			f.setType(hexa::RBJFilterType::peak);
+			f.setCutoff(Type(1000));
+		});
+
+		benchGrid<hexa::BiquadCascade<Type, 3>, Type>(runner, "BiquadCascade x3", [](auto& f)
+		{
+			f.setSection(0, hexa::RBJFilterType::LS, Type(200), Type(0.7), Type(3));
+			f.setSection(1, hexa::RBJFilterType::peak, Type(1000), Type(1), Type(-4));
+			f.setSection(2, hexa::RBJFilterType::HS, Type(6000), Type(0.7), Type(2));
+		});
+
+		benchGrid<hexa::SallenKeyFilter<Type>, Type>(runner, "SallenKeyFilter", [](auto& f)
+		{
+			f.setType(hexa::SallenKeyFilterType::LP);
+			f.setFrequency(Type(1000));
+			f.setResonance(Type(0.5));
+		});
+
+		benchGrid<hexa::SymDiodeClipper<Type>, Type>(runner, "SymDiodeClipper", [](auto& f)
+		{
+			f.setGain(Type(12));
+		});
+
+		benchGrid<hexa::ActiveOnePoleFilter<Type>, Type>(runner, "ActiveOnePoleFilter", [](auto& f)
+		{
+			f.setFrequency(Type(1000));
+			f.setDrive(Type(12));
+		});
+
+		benchDelayGrid<Type>(runner);
+	}
+}
+
+HEXA_BENCH_SUITE(Processors)
+{
+	benchProcessors<float>(runner);
+	benchProcessors<double>(runner);
+}
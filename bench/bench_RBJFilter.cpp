@@ -0,0 +1,39 @@
+#include "hexa_Bench.h"
+
+#include <hexa/filters/hexa_RBJFilter.h>
+
+namespace
+{
+	template <typename Type>
+	void benchRBJ(hexa::bench::Runner& runner)
+	{
+		constexpr size_t blockSize = 512;
+
+		for (size_t nChans : { 2, 4, 8, 16, 32, 64 })
+		{
+			hexa::bench::PlanarBuffer<Type> io(nChans, blockSize);
+			io.fillNoise();
+
+			hexa::RBJFilter<Type> filter;
+			filter.prepare(Type(48000), nChans, blockSize);
+			filter.setType(hexa::RBJFilterType::peak);
+			filter.setCutoff(Type(1000));
+
+			runner.run("process", hexa::bench::typeName<Type>(), nChans, blockSize, [&]
+			{
+				filter.process(io.in(), io.out(), nChans, blockSize);
+			});
+
+			runner.run("processVectorized", hexa::bench::typeName<Type>(), nChans, blockSize, [&]
+			{
+				filter.processVectorized(io.in(), io.out(), nChans, blockSize);
+			});
+		}
+	}
+}
+
+HEXA_BENCH_SUITE(RBJFilter)
+{
+	benchRBJ<float>(runner);
+	benchRBJ<double>(runner);
+}
@@ -0,0 +1,63 @@
+#include "hexa_Bench.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include <hexa/core/hexa_Resampler.h>
+
+namespace
+{
+	// Timed per input frame for push() and per output frame for pull().
+	template <typename Type, hexa::InterpolationType interp>
+	void benchResampler(hexa::bench::Runner& runner, const std::string& name)
+	{
+		constexpr size_t blockSize = 512;
+		constexpr size_t nChans = 2;
+		const char* type = hexa::bench::typeName<Type>();
+
+		for (auto [inRate, outRate] : { std::pair{ 44100, 48000 }, std::pair{ 48000, 44100 }, std::pair{ 96000, 48000 } })
+		{
+			const std::string rates = " " + std::to_string(inRate / 100) + "->" + std::to_string(outRate / 100);
+
+			hexa::Resampler<Type, interp> rs;
+			rs.prepare(double(inRate), double(outRate), nChans, blockSize);
+
+			// pull() asks for at most the history capacity, below blockSize + 128 frames.
+			hexa::bench::PlanarBuffer<Type> in(nChans, 2 * blockSize);
+			hexa::bench::PlanarBuffer<Type> out(nChans, std::max(blockSize, rs.getMaxOutputFrames(blockSize)));
+			in.fillNoise();
+
+			runner.run(name + rates + " push", type, nChans, blockSize, [&]
+			{
+				rs.push(in.in(), out.out(), nChans, blockSize);
+			});
+
+			runner.run(name + rates + " pull", type, nChans, blockSize, [&]
+			{
+				rs.pull(out.out(), nChans, blockSize, [&](Type** dst, size_t n)
+				{
+					for (size_t ch = 0; ch < nChans; ++ch) std::copy_n(in.in()[ch], n, dst[ch]);
+				});
+			});
+		}
+	}
+
+	template <typename Type>
+	void benchResamplers(hexa::bench::Runner& runner)
+	{
+		using IT = hexa::InterpolationType;
+
+		benchResampler<Type, IT::Linear>(runner, "Linear");
+		benchResampler<Type, IT::CatmullRom>(runner, "CatmullRom");
+		benchResampler<Type, IT::Sinc16>(runner, "Sinc16");
+		benchResampler<Type, IT::Sinc32>(runner, "Sinc32");
+		benchResampler<Type, IT::Sinc64>(runner, "Sinc64");
+	}
+}
+
+HEXA_BENCH_SUITE(Resampler)
+{
+	benchResamplers<float>(runner);
+	benchResamplers<double>(runner);
+}
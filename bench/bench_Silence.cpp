@@ -0,0 +1,117 @@
+#include "hexa_Bench.h"
+
+#include <algorithm>
+
+#include <hexa/core/hexa_DelayLine.h>
+#include <hexa/filters/hexa_ActiveOnePoleFilter.h>
+#include <hexa/filters/hexa_BiquadCascade.h>
+#include <hexa/filters/hexa_OnePoleFilter.h>
+#include <hexa/filters/hexa_RBJFilter.h>
+#include <hexa/filters/hexa_StateVariableFilter.h>
+
+namespace
+{
+	constexpr size_t blockSize = 256;
+	constexpr size_t nChans = 512;
+
+	/** A session of nChans channels of which the first numActive get noise and the rest silence. */
+	template <typename Type>
+	struct Session
+	{
+		explicit Session(size_t numActive) : in(nChans, blockSize), out(nChans, blockSize)
+		{
+			in.fillNoise();
+			for (size_t ch = numActive; ch < nChans; ++ch) std::fill_n(in.out()[ch], blockSize, Type(0));
+		}
+
+		hexa::bench::PlanarBuffer<Type> in, out;
+	};
+
+	/** Runs with the bypass off and on, the idle channels are past their tail before the timing starts. */
+	template <typename Type, typename Processor, typename Fn>
+	void benchBypass(hexa::bench::Runner& runner, const std::string& name, Processor& proc, Fn&& processBlock)
+	{
+		const char* type = hexa::bench::typeName<Type>();
+
+		for (size_t numActive : { size_t(0), nChans / 16 })
+		{
+			Session<Type> session(numActive);
+			const std::string label = name + (numActive == 0 ? " all idle" : " 1/16 active");
+
+			for (bool bypass : { false, true })
+			{
+				proc.setSilenceBypass(bypass);
+
+				const size_t primeBlocks = std::min(proc.getTailLength(), size_t(1) << 20) / blockSize + 2;
+				for (size_t b = 0; b < primeBlocks; ++b) processBlock(session.in.in(), session.out.out());
+
+				runner.run(label + (bypass ? " bypass" : ""), type, nChans, blockSize, [&]
+				{
+					processBlock(session.in.in(), session.out.out());
+				});
+			}
+		}
+	}
+
+	template <typename Type, typename Filter>
+	void benchFilter(hexa::bench::Runner& runner, const std::string& name, Filter& filter)
+	{
+		filter.prepare(Type(48000), nChans, blockSize);
+		benchBypass<Type>(runner, name, filter, [&](const Type** in, Type** out)
+		{
+			filter.process(in, out, nChans, blockSize);
+		});
+	}
+
+	template <typename Type>
+	void benchSilence(hexa::bench::Runner& runner)
+	{
+		{
+			hexa::OnePoleFilter<Type> filter;
+			filter.setCutoff(Type(200));
+			benchFilter<Type>(runner, "OnePole LP", filter);
+		}
+		{
+			hexa::StateVariableFilter<Type> filter;
+			filter.setCutoff(Type(200));
+			filter.setQ(Type(2));
+			benchFilter<Type>(runner, "StateVariable LP", filter);
+		}
+		{
+			hexa::RBJFilter<Type> filter;
+			filter.setCutoff(Type(200));
+			filter.setQ(Type(2));
+			benchFilter<Type>(runner, "RBJ LP", filter);
+		}
+		{
+			hexa::BiquadCascade<Type, 4> filter;
+			for (size_t i = 0; i < 4; ++i) filter.setSection(i, hexa::RBJFilterType::peak, Type(250 * (i + 1)), Type(1), Type(6));
+			benchFilter<Type>(runner, "BiquadCascade<4> peak", filter);
+		}
+		{
+			hexa::ActiveOnePoleFilter<Type> filter;
+			filter.setFrequency(Type(2000));
+			filter.setSolver(hexa::ActiveOnePoleSolver::FixedNewton);
+			benchFilter<Type>(runner, "ActiveOnePole FixedNewton", filter);
+		}
+		{
+			constexpr size_t delay = 4800;
+			hexa::DelayLine<Type> dl(static_cast<int>(delay + blockSize + 4), nChans);
+
+			benchBypass<Type>(runner, "DelayLine CatmullRom", dl, [&](const Type** in, Type** out)
+			{
+				for (size_t ch = 0; ch < nChans; ++ch)
+				{
+					dl.pushBlock(ch, in[ch], blockSize);
+					dl.readBlock(ch, delay, out[ch], blockSize, 0.5);
+				}
+			});
+		}
+	}
+}
+
+HEXA_BENCH_SUITE(Silence)
+{
+	benchSilence<float>(runner);
+	benchSilence<double>(runner);
+}
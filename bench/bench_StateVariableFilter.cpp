@@ -0,0 +1,50 @@
+#include "hexa_Bench.h"
+
+#include <cmath>
+#include <vector>
+
+#include <hexa/filters/hexa_StateVariableFilter.h>
+
+namespace
+{
+	template <typename Type>
+	void benchSVFModulation(hexa::bench::Runner& runner)
+	{
+		constexpr size_t blockSize = 512;
+		const char* type = hexa::bench::typeName<Type>();
+
+		std::vector<Type> cutoffs(blockSize);
+		for (size_t n = 0; n < blockSize; ++n) cutoffs[n] = Type(1000 + 800 * std::sin(0.05 * double(n)));
+
+		for (size_t nChans : { 1, 2, 8 })
+		{
+			hexa::bench::PlanarBuffer<Type> io(nChans, blockSize);
+			io.fillNoise();
+
+			hexa::StateVariableFilter<Type> filter;
+			filter.prepare(Type(48000), nChans, blockSize);
+
+			runner.run("setCutoff per sample", type, nChans, blockSize, [&]
+			{
+				auto in = io.in();
+				auto out = io.out();
+				for (size_t n = 0; n < blockSize; ++n)
+				{
+					filter.setCutoff(cutoffs[n]);
+					for (size_t ch = 0; ch < nChans; ++ch) out[ch][n] = filter(in[ch][n], ch);
+				}
+			});
+
+			runner.run("processModulated", type, nChans, blockSize, [&]
+			{
+				filter.processModulated(io.in(), io.out(), cutoffs.data(), nChans, blockSize);
+			});
+		}
+	}
+}
+
+HEXA_BENCH_SUITE(StateVariableFilter)
+{
+	benchSVFModulation<float>(runner);
+	benchSVFModulation<double>(runner);
+}
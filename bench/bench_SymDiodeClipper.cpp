@@ -0,0 +1,45 @@
+#include "hexa_Bench.h"
+
+#include <hexa/filters/hexa_SymDiodeClipper.h>
+
+namespace
+{
+	template <typename Type>
+	void benchDiodeClipper(hexa::bench::Runner& runner)
+	{
+		constexpr size_t blockSize = 512;
+		const char* type = hexa::bench::typeName<Type>();
+
+		for (size_t nChans : { 1, 2 })
+		{
+			hexa::bench::PlanarBuffer<Type> in(nChans, blockSize), out(nChans, blockSize);
+			in.fillNoise();
+
+			hexa::SymDiodeClipper<Type> clipper;
+			clipper.prepare(Type(48000), nChans, blockSize);
+			clipper.setFrequency(Type(2000));
+			clipper.setGain(Type(20));
+
+			runner.run("SymDiodeClipper Newton", type, nChans, blockSize, [&]
+			{
+				clipper.process(in.in(), out.out(), nChans, blockSize);
+			});
+			runner.reportSolverStats("SymDiodeClipper Newton", clipper.getSolverStats());
+
+			clipper.setSolver(hexa::DiodeClipperSolver::Table);
+			clipper.resetSolverStats();
+
+			runner.run("SymDiodeClipper Table", type, nChans, blockSize, [&]
+			{
+				clipper.process(in.in(), out.out(), nChans, blockSize);
+			});
+			runner.reportSolverStats("SymDiodeClipper Table", clipper.getSolverStats());
+		}
+	}
+}
+
+HEXA_BENCH_SUITE(SymDiodeClipper)
+{
+	benchDiodeClipper<float>(runner);
+	benchDiodeClipper<double>(runner);
+}
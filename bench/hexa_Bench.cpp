@@ -0,0 +1,153 @@
+#include "hexa_Bench.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include <hexa/core/hexa_Simd.h>
+
+namespace hexa::bench
+{
+	namespace
+	{
+		std::vector<std::pair<const char*, SuiteFn>>& suites()
+		{
+			static std::vector<std::pair<const char*, SuiteFn>> s;
+			return s;
+		}
+	}
+
+	bool registerSuite(const char* name, SuiteFn fn)
+	{
+		suites().emplace_back(name, fn);
+		return true;
+	}
+
+	void Runner::report(Result r)
+	{
+		if (!quiet) std::printf("%-52s %-7s ch=%-3zu block=%-5zu %9.3f ns/sample %10.2f Msamples/s\n",
+			(r.suite + "/" + r.name).c_str(), r.type.c_str(), r.channels, r.blockSize,
+			r.nsPerSample, r.samplesPerSecond * 1.e-6);
+		std::fflush(stdout);
+
+		results.push_back(std::move(r));
+	}
+
+	void Runner::reportSolverStats(const std::string& name, const SolverStats& stats) const
+	{
+		if (!SolverStats::enabled || quiet) return;
+		if (!filter.empty() && (suite + "/" + name).find(filter) == std::string::npos) return;
+
+		std::printf("    %llu solves, %.2f iterations mean, %zu max, %llu cap hits, %llu backtracks, max |F| %.3g\n      iterations:",
+			(unsigned long long)stats.numSolves, stats.getMeanIterations(), stats.getMaxIterations(),
+			(unsigned long long)stats.numCapHits, (unsigned long long)stats.numBacktracks, stats.maxResidual);
+
+		for (size_t i = 0; i < SolverStats::numBins; ++i)
+		{
+			if (stats.iterations[i] != 0) std::printf(" %zu:%.1f%%", i, 100. * double(stats.iterations[i]) / double(stats.numSolves));
+		}
+		std::printf("\n");
+		std::fflush(stdout);
+	}
+
+	namespace
+	{
+		const char* simdName() noexcept
+		{
+#if defined(HEXA_SIMD_AVX)
+			return "avx";
+#elif defined(HEXA_SIMD_SSE2)
+			return "sse2";
+#else
+			return "scalar";
+#endif
+		}
+
+		const char* compilerName() noexcept
+		{
+#if defined(__clang__)
+			return "clang " __clang_version__;
+#elif defined(__GNUC__)
+			return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+			return "msvc";
+#else
+			return "unknown";
+#endif
+		}
+
+		std::string quoted(const std::string& s)
+		{
+			std::string q{ "\"" };
+			for (char c : s)
+			{
+				if (c == '"' || c == '\\') q += '\\';
+				q += c;
+			}
+			return q + '"';
+		}
+
+		/** One result per line, so two runs can be compared with a plain diff. */
+		void writeJson(std::FILE* file, const std::vector<Result>& results)
+		{
+			std::fprintf(file, "{\n\t\"simd\": %s,\n\t\"compiler\": %s,\n\t\"results\": [\n",
+				quoted(simdName()).c_str(), quoted(compilerName()).c_str());
+
+			for (size_t i = 0; i < results.size(); ++i)
+			{
+				const auto& r = results[i];
+				std::fprintf(file, "\t\t{ \"suite\": %s, \"name\": %s, \"type\": %s, \"channels\": %zu, \"blockSize\": %zu, "
+					"\"nsPerSample\": %.4f, \"samplesPerSecond\": %.1f }%s\n",
+					quoted(r.suite).c_str(), quoted(r.name).c_str(), quoted(r.type).c_str(), r.channels, r.blockSize,
+					r.nsPerSample, r.samplesPerSecond, i + 1 < results.size() ? "," : "");
+			}
+
+			std::fprintf(file, "\t]\n}\n");
+		}
+	}
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+	hexa::bench::Runner runner;
+	const char* jsonPath = nullptr;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) runner.filter = argv[++i];
+		else if (!std::strcmp(argv[i], "--time") && i + 1 < argc) runner.minSeconds = std::atof(argv[++i]);
+		else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) jsonPath = argv[++i];
+		else
+		{
+			std::printf("usage: hexa_bench [--filter <substring>] [--time <seconds per case>] [--json <file, - for stdout>]\n");
+			return 1;
+		}
+	}
+
+	// JSON on stdout replaces the table.
+	const bool jsonToStdout = jsonPath != nullptr && !std::strcmp(jsonPath, "-");
+	runner.quiet = jsonToStdout;
+
+	for (auto&& [name, fn] : hexa::bench::suites())
+	{
+		runner.beginSuite(name);
+		fn(runner);
+	}
+
+	if (jsonPath != nullptr)
+	{
+		std::FILE* file = jsonToStdout ? stdout : std::fopen(jsonPath, "w");
+		if (file == nullptr)
+		{
+			std::fprintf(stderr, "hexa_bench: cannot write %s\n", jsonPath);
+			return 1;
+		}
+
+		hexa::bench::writeJson(file, runner.getResults());
+		if (file != stdout) std::fclose(file);
+	}
+
+	return 0;
+}
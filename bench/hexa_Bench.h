@@ -0,0 +1,143 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <hexa/core/hexa_DataBuffer.h>
+#include <hexa/core/hexa_SolverStats.h>
+
+namespace hexa::bench
+{
+	//==============================================================================
+	template <typename Type> constexpr const char* typeName() noexcept;
+	template <> constexpr const char* typeName<float>() noexcept { return "float"; }
+	template <> constexpr const char* typeName<double>() noexcept { return "double"; }
+
+	/** Keeps the optimizer from dropping a result that is otherwise unused. */
+	template <typename Type>
+	inline void doNotOptimize(const Type& value) noexcept
+	{
+#if defined(__GNUC__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const Type* sink;
+		sink = &value;
+#endif
+	}
+
+	//==============================================================================
+	/** Planar multichannel buffer with the pointer tables every hexa process() expects. */
+	template <typename Type>
+	class PlanarBuffer
+	{
+	public:
+		PlanarBuffer(size_t numChannels, size_t numFrames) : data(numFrames, numChannels)
+		{
+			for (size_t ch = 0; ch < numChannels; ++ch)
+			{
+				writePtrs.push_back(data.col(ch));
+				readPtrs.push_back(data.col(ch));
+			}
+		}
+
+		void fillNoise(Type amplitude = Type(1), uint32_t seed = 1)
+		{
+			std::mt19937 rng(seed);
+			std::uniform_real_distribution<Type> dist(-amplitude, amplitude);
+			for (size_t ch = 0; ch < data.getNumCols(); ++ch)
+			{
+				Type* col = data.col(ch);
+				for (size_t n = 0; n < data.getNumRows(); ++n) col[n] = dist(rng);
+			}
+		}
+
+		const Type** in() noexcept { return readPtrs.data(); }
+
+		Type** out() noexcept { return writePtrs.data(); }
+
+		size_t getNumChannels() const noexcept { return data.getNumCols(); }
+
+		size_t getNumFrames() const noexcept { return data.getNumRows(); }
+
+	private:
+		DataBuffer<Type, std::allocator<Type>, AlignedStorage<64>> data;
+		std::vector<const Type*> readPtrs;
+		std::vector<Type*> writePtrs;
+	};
+
+	//==============================================================================
+	struct Result
+	{
+		std::string suite, name, type;
+		size_t channels{}, blockSize{};
+		double nsPerSample{}, samplesPerSecond{};
+	};
+
+	/**
+	 * Times a block callback until a minimum wall time has passed, and reports the
+	 * cost per processed sample (a sample being one frame of one channel).
+	 */
+	class Runner
+	{
+	public:
+		double minSeconds{ 0.05 };
+		std::string filter{};
+		bool quiet{ false };
+
+		void beginSuite(const std::string& suiteName) { suite = suiteName; }
+
+		template <typename Fn>
+		void run(const std::string& name, const char* type, size_t channels, size_t blockSize, Fn&& processBlock)
+		{
+			if (!filter.empty() && (suite + "/" + name).find(filter) == std::string::npos) return;
+
+			using Clock = std::chrono::steady_clock;
+
+			processBlock();
+
+			// Blocks are timed in batches that grow until the clock reads are negligible, so
+			// a 16 sample block and a 64 channel by 4096 one both finish close to minSeconds.
+			size_t numBlocks = 0, batch = 1;
+			const auto start = Clock::now();
+			auto now = start;
+			const auto minDuration = std::chrono::duration<double>(minSeconds);
+			do
+			{
+				for (size_t i = 0; i < batch; ++i) processBlock();
+				numBlocks += batch;
+				now = Clock::now();
+				if (now - start < minDuration / 64) batch *= 2;
+			} while (now - start < minDuration);
+
+			const double seconds = std::chrono::duration<double>(now - start).count();
+			const double samples = double(numBlocks) * double(channels) * double(blockSize);
+
+			report({ suite, name, type, channels, blockSize, seconds * 1.e9 / samples, samples / seconds });
+		}
+
+		const std::vector<Result>& getResults() const noexcept { return results; }
+
+		/** Prints the stats of the run named name, built with HEXA_SOLVER_STATS only. */
+		void reportSolverStats(const std::string& name, const SolverStats& stats) const;
+
+	private:
+		void report(Result r);
+
+		std::string suite{};
+		std::vector<Result> results{};
+	};
+
+	//==============================================================================
+	using SuiteFn = void (*)(Runner&);
+
+	bool registerSuite(const char* name, SuiteFn fn);
+}
+
+/** Defines and registers a benchmark suite, run by hexa_bench in link order. */
+#define HEXA_BENCH_SUITE(suiteName) \
+	static void suiteName(hexa::bench::Runner&); \
+	static const bool suiteName##Registered = hexa::bench::registerSuite(#suiteName, &suiteName); \
+	static void suiteName(hexa::bench::Runner& runner)
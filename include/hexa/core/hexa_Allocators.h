@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "hexa_General.h"
+
+namespace hexa
+{
+	/**
+	 * Monotonic arena: one up-front reservation, O(1) bump allocation, release is a no-op and
+	 * everything is given back at once by reset(). Not thread-safe, every engine (or thread)
+	 * should own its arena.
+	 */
+	class Arena
+	{
+	public:
+		explicit Arena(size_t capacityInBytes)
+			: storage(static_cast<std::byte*>(::operator new(capacityInBytes, std::align_val_t{ blockAlignment }))),
+			capacity(capacityInBytes)
+		{
+		}
+
+		~Arena()
+		{
+			::operator delete(storage, std::align_val_t{ blockAlignment });
+		}
+
+		Arena(const Arena& other) = delete;
+		Arena& operator= (const Arena& other) = delete;
+
+		//==============================================================================
+		void* allocate(size_t bytes, size_t alignment)
+		{
+			const size_t start = utils::alignUp(used, alignment);
+			if (start + bytes > capacity) throw std::bad_alloc();
+
+			used = start + bytes;
+			return storage + start;
+		}
+
+		void deallocate([[maybe_unused]] void* ptr, [[maybe_unused]] size_t bytes) noexcept {}
+
+		/** Releases all allocations, previously allocated memory must not be used anymore. */
+		void reset() noexcept { used = 0; }
+
+		//==============================================================================
+		size_t getUsed() const noexcept { return used; }
+
+		size_t getCapacity() const noexcept { return capacity; }
+
+	private:
+		static constexpr size_t blockAlignment = 64;
+
+		std::byte* storage{};
+		size_t capacity{}, used{};
+	};
+
+	//==============================================================================
+	/**
+	 * Fixed-block pool: numBlocks blocks of blockSize bytes (rounded up to 64) reserved up
+	 * front, O(1) allocate/release through an intrusive free list. An allocation larger than
+	 * a block throws std::bad_alloc. Not thread-safe, as the Arena.
+	 */
+	class Pool
+	{
+	public:
+		Pool(size_t blockSizeInBytes, size_t numBlocks)
+			: blockSize(utils::alignUp(std::max(blockSizeInBytes, sizeof(void*)), blockAlignment)),
+			totalSize(blockSize * numBlocks)
+		{
+			storage = static_cast<std::byte*>(::operator new(totalSize, std::align_val_t{ blockAlignment }));
+
+			// Thread the free list through the blocks.
+			for (size_t i = numBlocks; i > 0; --i)
+			{
+				auto* block = storage + (i - 1) * blockSize;
+				*reinterpret_cast<void**>(block) = freeList;
+				freeList = block;
+			}
+		}
+
+		~Pool()
+		{
+			::operator delete(storage, std::align_val_t{ blockAlignment });
+		}
+
+		Pool(const Pool& other) = delete;
+		Pool& operator= (const Pool& other) = delete;
+
+		//==============================================================================
+		void* allocate(size_t bytes, size_t alignment)
+		{
+			if (bytes > blockSize || alignment > blockAlignment || freeList == nullptr) throw std::bad_alloc();
+
+			void* block = freeList;
+			freeList = *static_cast<void**>(block);
+			++numUsed;
+			return block;
+		}
+
+		void deallocate(void* ptr, [[maybe_unused]] size_t bytes) noexcept
+		{
+			assert(ptr >= storage && ptr < storage + totalSize);
+			*static_cast<void**>(ptr) = freeList;
+			freeList = ptr;
+			--numUsed;
+		}
+
+		//==============================================================================
+		size_t getBlockSize() const noexcept { return blockSize; }
+
+		size_t getNumUsedBlocks() const noexcept { return numUsed; }
+
+		size_t getNumBlocks() const noexcept { return totalSize / blockSize; }
+
+	private:
+		static constexpr size_t blockAlignment = 64;
+
+		size_t blockSize{}, totalSize{}, numUsed{};
+		std::byte* storage{};
+		void* freeList{};
+	};
+
+	//==============================================================================
+	/** Makes a resource current on this thread for default constructed ResourceAllocators. */
+	template <typename Resource>
+	class ScopedResource
+	{
+	public:
+		explicit ScopedResource(Resource& res) noexcept : previous(current())
+		{
+			current() = &res;
+		}
+
+		~ScopedResource()
+		{
+			current() = previous;
+		}
+
+		ScopedResource(const ScopedResource& other) = delete;
+		ScopedResource& operator= (const ScopedResource& other) = delete;
+
+		/** The current resource of this thread (nullptr if none). */
+		static Resource*& current() noexcept
+		{
+			thread_local Resource* res = nullptr;
+			return res;
+		}
+
+	private:
+		Resource* previous{};
+	};
+
+	//==============================================================================
+	/**
+	 * Standard allocator drawing from an Arena or a Pool. A default constructed one (which is
+	 * what DataBuffer and DelayLine create) uses the resource made current on this thread by
+	 * a ScopedResource, or the global heap when there is none.
+	 *
+	 * @code
+	 *	hexa::Arena arena(64 << 20);
+	 *	{
+	 *		hexa::ScopedResource<hexa::Arena> scope(arena);
+	 *		delay = std::make_unique<hexa::DelayLine<float, InterpolationType::Linear, hexa::ArenaAllocator<float>>>(48000);
+	 *	}
+	 * @endcode
+	 */
+	template <typename Type, typename Resource>
+	class ResourceAllocator
+	{
+	public:
+		using value_type = Type;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::false_type;
+
+		template <typename Other>
+		struct rebind { using other = ResourceAllocator<Other, Resource>; };
+
+		ResourceAllocator() noexcept : resource(ScopedResource<Resource>::current()) {}
+
+		explicit ResourceAllocator(Resource* res) noexcept : resource(res) {}
+
+		template <typename Other>
+		ResourceAllocator(const ResourceAllocator<Other, Resource>& other) noexcept : resource(other.getResource()) {}
+
+		//==============================================================================
+		Type* allocate(size_t n)
+		{
+			const size_t bytes = n * sizeof(Type);
+			if (resource == nullptr) return static_cast<Type*>(::operator new(bytes, std::align_val_t{ alignof(Type) }));
+			return static_cast<Type*>(resource->allocate(bytes, alignof(Type)));
+		}
+
+		void deallocate(Type* ptr, size_t n) noexcept
+		{
+			if (resource == nullptr) ::operator delete(ptr, std::align_val_t{ alignof(Type) });
+			else resource->deallocate(ptr, n * sizeof(Type));
+		}
+
+		Resource* getResource() const noexcept { return resource; }
+
+		template <typename Other>
+		friend bool operator== (const ResourceAllocator& a, const ResourceAllocator<Other, Resource>& b) noexcept
+		{
+			return a.getResource() == b.getResource();
+		}
+
+		template <typename Other>
+		friend bool operator!= (const ResourceAllocator& a, const ResourceAllocator<Other, Resource>& b) noexcept
+		{
+			return !(a == b);
+		}
+
+	private:
+		Resource* resource{};
+	};
+
+	template <typename Type>
+	using ArenaAllocator = ResourceAllocator<Type, Arena>;
+
+	template <typename Type>
+	using PoolAllocator = ResourceAllocator<Type, Pool>;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace hexa
+{
+	/**
+	 * Serial chain of processors fused into one loop: every sample goes through all stages
+	 * (their operator() (x, ch)) before the next one is read, so there are no intermediate
+	 * buffers and the compiler can inline across the stages. The stages keep their own
+	 * parameters, reach them through get<I>(). Changes posted to a stage and its denormal
+	 * protection are applied per block through its beginBlock(), its silence bypass is not
+	 * used.
+	 *
+	 * @code
+	 *	hexa::Chain<hexa::OnePoleFilter<float>, hexa::SymDiodeClipper<float>, hexa::RBJFilter<float>> strip;
+	 *	strip.prepare(48000.f, 2, 512);
+	 *	strip.get<0>().setType(hexa::OnePoleType::HP);
+	 *	strip.process(inputs, outputs, 2, 512);
+	 * @endcode
+	 */
+	template <typename... Procs>
+	class Chain final
+	{
+		static_assert(sizeof...(Procs) > 0, "Chain needs at least one stage");
+
+	public:
+		Chain() = default;
+
+		//==============================================================================
+		static constexpr size_t getNumStages() noexcept { return sizeof...(Procs); }
+
+		template <size_t I>
+		auto& get() noexcept { return std::get<I>(stages); }
+
+		template <size_t I>
+		const auto& get() const noexcept { return std::get<I>(stages); }
+
+		//==============================================================================
+		template <typename Type>
+		void prepare(Type sRate, size_t numChannels, size_t maxBlockSize)
+		{
+			std::apply([&](auto&... proc) { (proc.prepare(sRate, numChannels, maxBlockSize), ...); }, stages);
+		}
+
+		/**
+		 * Calls beginBlock() of every stage that has one (a nested Chain included), keep the
+		 * result alive until the block is done. process() calls it.
+		 *
+		 * A processor's beginBlock() is its per-block setup: it applies the parameter changes
+		 * posted since the last block and returns the DenormalProtection scope of its states.
+		 * Its own block entry points call it first, and as the stages of a Chain run through
+		 * operator() (x, ch), the Chain calls it for them.
+		 */
+		auto beginBlock() noexcept
+		{
+			return std::apply([](auto&... proc) { return std::make_tuple(beginBlockOf(proc)...); }, stages);
+		}
+
+		template <typename Type>
+		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
+		{
+			const auto blockScopes = beginBlock();
+
+			for (size_t ch = 0; ch < nChans; ++ch)
+			{
+				const Type* in = inputs[ch];
+				Type* out = outputs[ch];
+
+				for (size_t n = 0; n < nFrames; ++n)
+				{
+					out[n] = tick(in[n], ch, std::index_sequence_for<Procs...>{});
+				}
+			}
+		}
+
+		template <typename Type>
+		Type processSample(const Type& x, size_t ch) noexcept
+		{
+			return tick(x, ch, std::index_sequence_for<Procs...>{});
+		}
+
+		// Same as processSample, so a Chain can be a stage of another Chain
+		template <typename Type>
+		Type operator() (const Type& x, size_t ch) noexcept
+		{
+			return tick(x, ch, std::index_sequence_for<Procs...>{});
+		}
+
+		void reset() noexcept
+		{
+			std::apply([](auto&... proc) { (proc.reset(), ...); }, stages);
+		}
+
+	private:
+		struct NoBlockScope {};
+
+		template <typename Proc, typename = void>
+		struct HasBeginBlock : std::false_type {};
+
+		template <typename Proc>
+		struct HasBeginBlock<Proc, std::void_t<decltype(std::declval<Proc&>().beginBlock())>> : std::true_type {};
+
+		template <typename Proc>
+		static auto beginBlockOf(Proc& proc) noexcept
+		{
+			if constexpr (HasBeginBlock<Proc>::value)
+				return proc.beginBlock();
+			else
+				return NoBlockScope{};
+		}
+
+		template <typename Type, size_t... I>
+		Type tick(Type x, size_t ch, std::index_sequence<I...>) noexcept
+		{
+			((x = std::get<I>(stages)(x, ch)), ...);
+			return x;
+		}
+
+		//==============================================================================
+		std::tuple<Procs...> stages;
+	};
+}
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "hexa_DataBuffer.h"
+#include "hexa_FFT.h"
+#include "hexa_Simd.h"
+
+namespace hexa
+{
+	template <typename Type>
+	using SpectrumBuffer = DataBuffer<Type, std::allocator<Type>, AlignedStorage<64>>;
+
+	/**
+	 * Impulse response prepared for Convolver: the first partition as reversed FIR taps and
+	 * the rest as the spectra of zero-padded partitions of partitionSize samples (one re and
+	 * one im column per partition). Immutable once built, so one instance can be shared
+	 * through std::shared_ptr<const ConvolutionIR> by any number of channels and Convolvers.
+	 */
+	template <typename Type>
+	class ConvolutionIR
+	{
+	public:
+		/** partitionSize is rounded up to a power of 2 (at least 16). */
+		ConvolutionIR(const Type* ir, size_t length, size_t newPartitionSize = 256)
+			: partitionSize{ std::max<size_t>(utils::nextPowerOfTwo(newPartitionSize), 16) }
+			, irLength{ length }
+			, head(partitionSize, 1)
+		{
+			const size_t B = partitionSize;
+
+			for (size_t k = 0; k < std::min(B, length); ++k) head(B - 1 - k, 0) = ir[k];
+
+			numPartitions = length > B ? (length - 1) / B : 0;
+			partitions.resize(B + 1, 2 * numPartitions);
+
+			FFT<Type> fft(2 * B);
+			std::vector<Type> block(2 * B);
+
+			for (size_t p = 0; p < numPartitions; ++p)
+			{
+				const size_t start = (p + 1) * B;
+				const size_t count = std::min(B, length - start);
+
+				std::fill(block.begin(), block.end(), Type(0));
+				std::copy(ir + start, ir + start + count, block.begin());
+				fft.forward(block.data(), partitions.col(2 * p), partitions.col(2 * p + 1));
+			}
+		}
+
+		static std::shared_ptr<const ConvolutionIR> make(const Type* ir, size_t length, size_t partitionSize = 256)
+		{
+			return std::make_shared<const ConvolutionIR>(ir, length, partitionSize);
+		}
+
+		//==============================================================================
+		size_t getPartitionSize() const noexcept { return partitionSize; }
+
+		/** Number of FFT partitions, not counting the direct-form head. */
+		size_t getNumPartitions() const noexcept { return numPartitions; }
+
+		size_t getLength() const noexcept { return irLength; }
+
+		/** The first partitionSize taps, last one first. */
+		const Type* getHead() const noexcept { return head.col(0); }
+
+		const Type* getRe(size_t p) const noexcept { return partitions.col(2 * p); }
+
+		const Type* getIm(size_t p) const noexcept { return partitions.col(2 * p + 1); }
+
+	private:
+		size_t partitionSize{}, irLength{}, numPartitions{};
+		SpectrumBuffer<Type> head;
+		SpectrumBuffer<Type> partitions{ 0, 0 };
+	};
+
+	//==============================================================================
+	/**
+	 * Zero latency, uniformly partitioned overlap-save convolver. The first partition runs as
+	 * a direct-form FIR on every sample, the others (partition p applied to input delayed by
+	 * p + 1 partitions) in the frequency domain, once per partitionSize input samples. As the
+	 * FFT part only needs past blocks, its output is ready before it is due and any host block
+	 * size works. The frequency-domain delay line of every channel lives in an aligned
+	 * DataBuffer, the IR is shared read-only.
+	 *
+	 * The partition size trades the head cost (partitionSize MACs per sample) against the FFT
+	 * part, which streams all IR and input spectra once per block and so gets memory bound on
+	 * long IRs: 128-256 suits 0.5 s, 512 or more suits several seconds.
+	 */
+	template <typename Type>
+	class Convolver
+	{
+	public:
+		Convolver() = default;
+
+		/** Not realtime safe: reallocates the channel states when the partitioning changes. */
+		void setImpulseResponse(std::shared_ptr<const ConvolutionIR<Type>> newIR)
+		{
+			const bool resized = !ir || !newIR || ir->getPartitionSize() != newIR->getPartitionSize()
+				|| ir->getNumPartitions() != newIR->getNumPartitions();
+
+			ir = std::move(newIR);
+			if (resized) allocate();
+			else reset();
+		}
+
+		const std::shared_ptr<const ConvolutionIR<Type>>& getImpulseResponse() const noexcept { return ir; }
+
+		/** Always 0, the head FIR covers the first partition. */
+		size_t getLatency() const noexcept { return 0; }
+
+		//==============================================================================
+		void prepare(Type sRate, size_t numChannels, size_t maxBlockSize)
+		{
+			(void)sRate; (void)maxBlockSize;
+			channels.resize(numChannels);
+			allocate();
+		}
+
+		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
+		{
+			assert(nChans <= channels.size());
+
+			if (!ir)
+			{
+				for (size_t ch = 0; ch < nChans; ++ch) std::fill_n(outputs[ch], nFrames, Type(0));
+				return;
+			}
+
+			const size_t B = ir->getPartitionSize();
+
+			for (size_t done = 0; done < nFrames;)
+			{
+				const size_t len = std::min(nFrames - done, B - fill);
+
+				for (size_t ch = 0; ch < nChans; ++ch)
+				{
+					processHead(channels[ch], inputs[ch] + done, outputs[ch] + done, len);
+				}
+
+				fill += len;
+				done += len;
+
+				if (fill == B)
+				{
+					for (size_t ch = 0; ch < nChans; ++ch) processPartitions(channels[ch]);
+
+					fdlPos = fdlPos + 1 < ir->getNumPartitions() ? fdlPos + 1 : 0;
+					fill = 0;
+				}
+			}
+		}
+
+		void reset() noexcept
+		{
+			for (auto&& state : channels)
+			{
+				state.history.clear();
+				state.blocks.clear();
+				state.fdl.clear();
+				state.pos = 0;
+			}
+			fill = 0;
+			fdlPos = 0;
+		}
+
+	private:
+		struct Channel
+		{
+			SpectrumBuffer<Type> history{ 0, 0 };	// head FIR input, written twice for a contiguous window
+			SpectrumBuffer<Type> blocks{ 0, 0 };	// previous and current input block, FFT part output
+			SpectrumBuffer<Type> fdl{ 0, 0 };		// input spectra, one re and one im column per partition
+			size_t pos{};
+		};
+
+		void allocate()
+		{
+			const size_t B = ir ? ir->getPartitionSize() : 16;
+			const size_t P = ir ? ir->getNumPartitions() : 0;
+
+			for (auto&& state : channels)
+			{
+				state.history.resize(2 * B, 1);
+				state.blocks.resize(B, 3);
+				state.fdl.resize(B + 1, 2 * P);
+			}
+
+			fft.resize(2 * B);
+			scratch.resize(2 * B, 3);
+			reset();
+		}
+
+		void processHead(Channel& state, const Type* in, Type* out, size_t len) noexcept
+		{
+			using Batch = simd::Batch<Type>;
+
+			const size_t B = ir->getPartitionSize();
+			const Type* taps = ir->getHead();
+			Type* hist = state.history.col(0);
+			Type* current = state.blocks.col(1) + fill;
+			const Type* tail = state.blocks.col(2) + fill;
+
+			for (size_t n = 0; n < len; ++n)
+			{
+				const Type x = in[n];
+				current[n] = x;
+				hist[state.pos] = x;
+				hist[state.pos + B] = x;
+				state.pos = (state.pos + 1) & (B - 1);
+
+				// The last B inputs, oldest first, start right after the one just written.
+				const Type* window = hist + (state.pos ? state.pos : B);
+
+				Batch acc0{ Type(0) }, acc1{ Type(0) };
+				size_t k = 0;
+				for (; k + 2 * Batch::size <= B; k += 2 * Batch::size)
+				{
+					acc0 = acc0 + Batch::load(taps + k) * Batch::load(window + k);
+					acc1 = acc1 + Batch::load(taps + k + Batch::size) * Batch::load(window + k + Batch::size);
+				}
+				for (; k + Batch::size <= B; k += Batch::size)
+				{
+					acc0 = acc0 + Batch::load(taps + k) * Batch::load(window + k);
+				}
+
+				alignas(64) Type lanes[Batch::size];
+				(acc0 + acc1).store(lanes);
+
+				Type y = tail[n];
+				for (size_t l = 0; l < Batch::size; ++l) y += lanes[l];
+				for (; k < B; ++k) y += taps[k] * window[k];
+
+				out[n] = y;
+			}
+		}
+
+		/** Runs once per full input block, leaves the FFT part of the next block in column 2. */
+		void processPartitions(Channel& state) noexcept
+		{
+			using Batch = simd::Batch<Type>;
+
+			const size_t B = ir->getPartitionSize();
+			const size_t P = ir->getNumPartitions();
+			const size_t numBins = B + 1;
+
+			if (P == 0) return;
+
+			Type* time = scratch.col(0);
+			std::copy_n(state.blocks.col(0), B, time);
+			std::copy_n(state.blocks.col(1), B, time + B);
+			std::copy_n(state.blocks.col(1), B, state.blocks.col(0));
+
+			fft.forward(time, state.fdl.col(2 * fdlPos), state.fdl.col(2 * fdlPos + 1));
+
+			Type* accRe = scratch.col(1);
+			Type* accIm = scratch.col(2);
+			std::fill_n(accRe, numBins, Type(0));
+			std::fill_n(accIm, numBins, Type(0));
+
+			// Y = sum X[k - p] H[p], newest input spectrum with the first partition.
+			for (size_t p = 0, slot = fdlPos; p < P; ++p, slot = slot ? slot - 1 : P - 1)
+			{
+				const Type* xr = state.fdl.col(2 * slot);
+				const Type* xi = state.fdl.col(2 * slot + 1);
+				const Type* hr = ir->getRe(p);
+				const Type* hi = ir->getIm(p);
+
+				size_t k = 0;
+				for (; k + Batch::size <= numBins; k += Batch::size)
+				{
+					const auto vxr = Batch::load(xr + k), vxi = Batch::load(xi + k);
+					const auto vhr = Batch::load(hr + k), vhi = Batch::load(hi + k);
+
+					(Batch::load(accRe + k) + vxr * vhr - vxi * vhi).store(accRe + k);
+					(Batch::load(accIm + k) + vxr * vhi + vxi * vhr).store(accIm + k);
+				}
+				for (; k < numBins; ++k)
+				{
+					accRe[k] += xr[k] * hr[k] - xi[k] * hi[k];
+					accIm[k] += xr[k] * hi[k] + xi[k] * hr[k];
+				}
+			}
+
+			fft.inverse(accRe, accIm, time);
+			std::copy_n(time + B, B, state.blocks.col(2));
+		}
+
+		//==============================================================================
+		std::shared_ptr<const ConvolutionIR<Type>> ir;
+		std::vector<Channel> channels;
+
+		FFT<Type> fft{ 32 };
+		SpectrumBuffer<Type> scratch{ 0, 0 };
+
+		size_t fill{}, fdlPos{};
+	};
+}
@@ -2,14 +2,53 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iterator>
 #include <vector>
 
+#include "hexa_General.h"
+
 namespace hexa
 {
-	template <typename Type, typename Alloc = std::allocator<Type>>
+	/** Default DataBuffer layout: columns packed back-to-back. */
+	struct PackedStorage
+	{
+		static constexpr size_t alignment = 0;
+		static constexpr size_t guard = 0;
+		static constexpr bool interleaved = false;
+	};
+
+	/** Row-major DataBuffer layout: a row is an interleaved frame, see frame(). */
+	struct InterleavedStorage
+	{
+		static constexpr size_t alignment = 0;
+		static constexpr size_t guard = 0;
+		static constexpr bool interleaved = true;
+	};
+
+	/**
+	 * DataBuffer layout with column starts aligned to Alignment bytes (the column stride is
+	 * rounded up to it, so 64 also keeps channels off each other's cache lines) and Guard
+	 * extra samples after every column, so kernels can read past the end without masking.
+	 */
+	template <size_t Alignment = 64, size_t Guard = 0>
+	struct AlignedStorage
+	{
+		static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment needs to be a power of 2");
+
+		static constexpr size_t alignment = Alignment;
+		static constexpr size_t guard = Guard;
+		static constexpr bool interleaved = false;
+	};
+
+	template <typename Type, typename Alloc = std::allocator<Type>, typename Storage = PackedStorage>
 	class DataBuffer
 	{
+		static_assert(Storage::alignment % sizeof(Type) == 0, "Alignment needs to be a multiple of the sample size");
+
+		// Alignment in samples (1 when packed).
+		static constexpr size_t alignSamples = Storage::alignment ? Storage::alignment / sizeof(Type) : 1;
+
 	public:
 		DataBuffer(const DataBuffer& other) = delete;
 		DataBuffer& operator= (const DataBuffer& other) = delete;
@@ -25,9 +64,18 @@ namespace hexa
 		void resize(size_t newNumRows, size_t newNumCols)
 		{
 			numRows = newNumRows; numCols = newNumCols;
-			rawData.resize(numRows * numCols, Type(0));
+			stride = strideFor(numRows, numCols);
+
+			// The reserve keeps the vector from rounding the capacity up (see pool allocators).
+			const size_t size = getAllocationSize(numRows, numCols) / sizeof(Type);
+			rawData.reserve(size);
+			rawData.resize(size, Type(0));
+
+			const auto address = reinterpret_cast<std::uintptr_t>(rawData.data());
+			offset = (utils::alignUp(address, std::uintptr_t(alignSamples * sizeof(Type))) - address) / sizeof(Type);
 		}
 
+		/** Zeroes all samples, including the guards. */
 		void clear() noexcept
 		{
 			std::fill(rawData.begin(), rawData.end(), Type(0));
@@ -35,12 +83,46 @@ namespace hexa
 
 		void clearColumn(size_t c) noexcept
 		{
-			std::fill_n(&rawData[flat(0, c)], numRows, Type(0));
+			if constexpr (Storage::interleaved)
+			{
+				for (size_t r = 0; r < numRows; ++r) rawData[flat(r, c)] = Type(0);
+			}
+			else
+			{
+				std::fill_n(&rawData[flat(0, c)], numRows, Type(0));
+			}
 		}
 
-		const Type* col(size_t c) const { return &rawData[flat(0, c)]; }
+		// The layout checks are templates, so they only fire on a call (not on an explicit
+		// instantiation of the class).
+		template <typename S = Storage>
+		const Type* col(size_t c) const
+		{
+			static_assert(!S::interleaved, "Columns of an interleaved buffer are not contiguous");
+			return &rawData[flat(0, c)];
+		}
 
-		Type* col(size_t c) { return &rawData[flat(0, c)]; }
+		template <typename S = Storage>
+		Type* col(size_t c)
+		{
+			static_assert(!S::interleaved, "Columns of an interleaved buffer are not contiguous");
+			return &rawData[flat(0, c)];
+		}
+
+		/** One interleaved frame (numCols samples) of an InterleavedStorage buffer. */
+		template <typename S = Storage>
+		const Type* frame(size_t r) const
+		{
+			static_assert(S::interleaved, "Rows of a planar buffer are not contiguous");
+			return &rawData[flat(r, 0)];
+		}
+
+		template <typename S = Storage>
+		Type* frame(size_t r)
+		{
+			static_assert(S::interleaved, "Rows of a planar buffer are not contiguous");
+			return &rawData[flat(r, 0)];
+		}
 
 		Type& operator() (size_t r, size_t c) { return rawData[flat(r, c)]; }
 
@@ -49,9 +131,16 @@ namespace hexa
 		void clearRegion(size_t startRow, size_t length)
 		{
 			assert(startRow + length < numRows);
-			for (size_t c = 0; c < numCols; ++c)
+			if constexpr (Storage::interleaved)
+			{
+				std::fill_n(&rawData[flat(startRow, 0)], length * numCols, Type(0));
+			}
+			else
 			{
-				std::fill_n(&rawData[flat(startRow, c)], length, Type(0));
+				for (size_t c = 0; c < numCols; ++c)
+				{
+					std::fill_n(&rawData[flat(startRow, c)], length, Type(0));
+				}
 			}
 		}
 
@@ -59,14 +148,37 @@ namespace hexa
 
 		size_t getNumCols() const noexcept { return numCols; }
 
-		Type* data() { return rawData.data(); }
+		/** Distance in samples between column starts (between frames for the interleaved layout). */
+		size_t getStride() const noexcept { return stride; }
 
-		const Type* data() const { return rawData.data(); }
+		static constexpr size_t getNumGuardSamples() noexcept { return Storage::guard; }
+
+		/** Bytes a buffer of these dimensions allocates, guards and alignment slack included (e.g. to size a Pool). */
+		static constexpr size_t getAllocationSize(size_t numRows, size_t numCols) noexcept
+		{
+			// Over-allocated, so the first column can be moved up to an aligned address.
+			const size_t size = Storage::interleaved ? numRows * numCols : strideFor(numRows, numCols) * numCols;
+			return (size + alignSamples - 1) * sizeof(Type);
+		}
+
+		/** The first column (or frame), the following ones are getStride() samples apart. */
+		Type* data() { return rawData.data() + offset; }
+
+		const Type* data() const { return rawData.data() + offset; }
 
 	private:
-		size_t flat(size_t row, size_t col) const noexcept { return row + numRows * col; }
+		static constexpr size_t strideFor(size_t numRows, size_t numCols) noexcept
+		{
+			return Storage::interleaved ? numCols : utils::alignUp(numRows + Storage::guard, alignSamples);
+		}
+
+		size_t flat(size_t row, size_t col) const noexcept
+		{
+			if constexpr (Storage::interleaved) return offset + row * stride + col;
+			else return offset + row + stride * col;
+		}
 
 		std::vector<Type, Alloc> rawData{};
-		size_t numRows{}, numCols{};
+		size_t numRows{}, numCols{}, stride{}, offset{};
 	};
-}
\ No newline at end of file
+}
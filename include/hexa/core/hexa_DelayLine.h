@@ -1,9 +1,16 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <memory>
 
 #include "hexa_DataBuffer.h"
+#include "hexa_General.h"
+#include "hexa_Silence.h"
+#include "hexa_Simd.h"
 #include "../math/hexa_Interpolators.h"
 
 namespace hexa
@@ -35,6 +42,8 @@ namespace hexa
 
 			buffer.resize(maxSize, newNumChannels);
 			pos.resize(newNumChannels, 0);
+			bypassed.resize(newNumChannels, 0);
+			silence.prepare(newNumChannels);
 
 			clear();
 		}
@@ -42,7 +51,9 @@ namespace hexa
 		void clear() noexcept
 		{
 			buffer.clear();
-			std::fill(pos.begin(), pos.end(), Type(0));
+			std::fill(pos.begin(), pos.end(), size_t(0));
+			std::fill(bypassed.begin(), bypassed.end(), uint8_t(0));
+			silence.reset();
 		}
 
 		//==============================================================================
@@ -52,22 +63,313 @@ namespace hexa
 
 		size_t getNumSamples() const noexcept { return buffer.getNumRows(); }
 
+		/**
+		 * Bytes the sample buffer of resize(reqSize, numChannels) allocates through Alloc, e.g. to
+		 * size a Pool. The per-channel state takes numAllocations - 1 more, of numChannels words each.
+		 */
+		static size_t getAllocationSize(int reqSize, size_t numChannels) noexcept
+		{
+			return Buffer::getAllocationSize(static_cast<size_t>(utils::nextPowerOfTwo(reqSize)), numChannels);
+		}
+
+		/** Allocations a delay line holds through Alloc: the sample buffer, pos, bypassed and the SilenceGate. */
+		static constexpr size_t numAllocations = 4;
+
+		//==============================================================================
+		/**
+		 * Tracks silence (at or below the threshold) per channel in pushBlock(). Once a channel
+		 * has been fed getTailLength() silent samples its buffer is cleared, and until the next
+		 * signal pushBlock() only moves the write position and the block reads return zeros.
+		 * Off by default.
+		 */
+		void setSilenceBypass(bool shouldBypass) noexcept { silence.setEnabled(shouldBypass); }
+
+		void setSilenceThreshold(Type newThreshold) noexcept { silence.setThreshold(newThreshold); }
+
+		bool isSilenceBypassEnabled() const noexcept { return silence.isEnabled(); }
+
+		/** Estimated tail, the longest delay the buffer holds as the line does not know the delays read. */
+		size_t getTailLength() const noexcept { return maxSize; }
+
+		/** true while channel ch is bypassed, everything it reads is zero. */
+		bool isSilent(size_t ch) const noexcept { return bypassed[ch] != 0; }
+
+		//==============================================================================
+		/**
+		 * Phases per sample of the sinc table, the tables are built once per size and shared
+		 * between all delay lines (allocates on the first use of a size). No effect for the
+		 * polynomial types.
+		 */
+		void setSincPhases(size_t numPhases)
+		{
+			if constexpr (isSinc) op.setNumPhases(numPhases);
+		}
+
 		//==============================================================================
 		void push(size_t ch, Type value) noexcept
 		{
+			// Single samples are not checked, they count as signal.
+			if (silence.isEnabled()) resume(ch);
+
 			auto&& lpos = pos[ch];
 
 			// Write AND Shift
 			buffer(lpos, ch) = value;
+			if (lpos < numGuard) buffer.col(ch)[maxSize + lpos] = value;
 			lpos = (lpos + 1) & sizeMsk;
 		}
 
+		/** Writes n samples at once, in at most two copies split at the wrap point. */
+		void pushBlock(size_t ch, const Type* src, size_t n) noexcept
+		{
+			assert(n <= maxSize);
+			auto&& lpos = pos[ch];
+			Type* dst = buffer.col(ch);
+
+			if (silence.canSkip(ch, src, n, maxSize))
+			{
+				// All the buffer holds is silence by now, zeroing it once makes the skip exact.
+				if (!bypassed[ch]) std::fill_n(dst, maxSize + numGuard, Type(0));
+				bypassed[ch] = 1;
+
+				lpos = (lpos + n) & sizeMsk;
+				return;
+			}
+			bypassed[ch] = 0;
+
+			const size_t first = std::min(n, maxSize - lpos);
+			std::copy_n(src, first, dst + lpos);
+			std::copy_n(src + first, n - first, dst);
+			std::copy_n(dst, numGuard, dst + maxSize);	// the guard mirrors the head
+
+			lpos = (lpos + n) & sizeMsk;
+		}
+
 		Type operator() (size_t ch, size_t del, double frac = 0) const noexcept
 		{
 			return interpolate(ch, del, frac);
 		}
 
+		/**
+		 * Reads n samples with a fixed delay, the same as calling operator() (ch, del, frac)
+		 * after each of the last n pushes, so it pairs with pushBlock. Integer reads are plain
+		 * copies; fractional ones run the interpolator as a short FIR over contiguous runs.
+		 */
+		void readBlock(size_t ch, size_t del, Type* dst, size_t n, double frac = 0) const noexcept
+		{
+			assert(del + n + numTaps <= maxSize);
+			if (bypassed[ch])
+			{
+				std::fill_n(dst, n, Type(0));
+				return;
+			}
+
+			const Type* src = buffer.col(ch);
+
+			// Position of the newest point for the first output sample.
+			const size_t base = (pos[ch] - (n - 1) - del) & sizeMsk;
+
+			if constexpr (interp == InterpolationType::Drop)
+			{
+				copyBlock(src, base, dst, n);
+			}
+			else
+			{
+				// These interpolators return their point centerTap at frac == 0.
+				constexpr bool exactAtZero = interp == InterpolationType::Linear
+					|| interp == InterpolationType::Lagrange3 || interp == InterpolationType::CatmullRom || isSinc;
+
+				if (exactAtZero && frac == 0)
+				{
+					copyBlock(src, (base - centerTap) & sizeMsk, dst, n);
+					return;
+				}
+
+				const auto w = getWeights(frac);
+
+				// The guard holds the points past the wrap, so a run only ends at the last
+				// output whose oldest point is in the buffer.
+				for (size_t i = 0; i < n;)
+				{
+					const size_t oldest = (base + i - (numTaps - 1)) & sizeMsk;
+					const size_t len = std::min(n - i, maxSize - oldest);
+					const Type* s = src + oldest;
+					Type* d = dst + i;
+
+					if constexpr (isSinc)
+					{
+						// SIMD lanes over the output samples.
+						op.getTable().convolve(w.data(), s, d, len);
+					}
+					else
+					{
+						for (size_t k = 0; k < len; ++k)
+						{
+							Type acc = 0;
+							for (size_t j = 0; j < numTaps; ++j) acc += w[j] * s[k + j];
+							d[k] = acc;
+						}
+					}
+
+					i += len;
+				}
+			}
+		}
+
+		/**
+		 * Reads many fractional delays at once (chorus voices, multi-tap echo). Each tap is the
+		 * same as operator() (ch, del, frac) with del and frac the integer and fractional part
+		 * of its delay.
+		 */
+		void readTaps(size_t ch, const Type* delays, Type* dst, size_t nTaps) const noexcept
+		{
+			if (bypassed[ch])
+			{
+				std::fill_n(dst, nTaps, Type(0));
+				return;
+			}
+
+			readFractional(ch, pos[ch], 0, delays, dst, nTaps);
+		}
+
+		/**
+		 * Per-sample modulated delay for a block: dst[i] is read with delays[i] as operator()
+		 * would after the i-th of the last n pushes, so it pairs with pushBlock.
+		 */
+		void readModulated(size_t ch, const Type* delays, Type* dst, size_t n) const noexcept
+		{
+			if (bypassed[ch])
+			{
+				std::fill_n(dst, n, Type(0));
+				return;
+			}
+
+			readFractional(ch, pos[ch] - (n - 1), 1, delays, dst, n);
+		}
+
 	private:
+		static constexpr size_t numTaps = Interpolator<Type, interp>::numPoints;
+		static constexpr bool isSinc = isSincInterpolation(interp);
+		static constexpr size_t chunkSize = 64;
+
+		// The point returned at frac == 0, counted from the newest one.
+		static constexpr size_t centerTap = isSinc ? numTaps / 2 - 1 : 1;
+
+		// Samples after every channel that mirror its first ones, so the points of a read
+		// are contiguous across the wrap.
+		static constexpr size_t numGuard = numTaps - 1;
+
+		using Buffer = DataBuffer<Type, Alloc, AlignedStorage<64, numGuard>>;
+
+		// The per-channel state goes through Alloc as well, so a Pool/Arena delay line never touches the heap.
+		template <typename T>
+		using AllocFor = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+		//==============================================================================
+		void resume(size_t ch) noexcept
+		{
+			bypassed[ch] = 0;
+			silence.restart(ch);
+		}
+
+		void copyBlock(const Type* src, size_t start, Type* dst, size_t n) const noexcept
+		{
+			const size_t first = std::min(n, maxSize - start);
+			std::copy_n(src + start, first, dst);
+			std::copy_n(src, n - first, dst + first);
+		}
+
+		/** The numTaps points up to newest, oldest first (reaching into the guard at the wrap). */
+		const Type* getOldest(const Type* src, size_t newest) const noexcept
+		{
+			return src + ((newest - (numTaps - 1)) & sizeMsk);
+		}
+
+		/**
+		 * Splits the delays into indices and fractions and gathers the interpolation points
+		 * into planar scratch, then runs the block evaluate() of the interpolator on them.
+		 * The sinc types read straight from the buffer instead.
+		 */
+		void readFractional(size_t ch, size_t startPos, size_t posStep, const Type* delays, Type* dst, size_t n) const noexcept
+		{
+			if constexpr (isSinc)
+			{
+				// A dot product with the blended table phase per read, the points of two reads
+				// rarely line up.
+				const Type* src = buffer.col(ch);
+
+				for (size_t k = 0; k < n; ++k)
+				{
+					assert(delays[k] >= 0 && static_cast<size_t>(delays[k]) + numTaps <= maxSize);
+					const auto di = static_cast<int64_t>(delays[k]);
+					const size_t idx = startPos + k * posStep - static_cast<size_t>(di);
+
+					dst[k] = op.getTable().dot(delays[k] - static_cast<Type>(di), getOldest(src, idx));
+				}
+			}
+			else
+			{
+				using Op = Interpolator<Type, interp>;
+
+				const Type* src = buffer.col(ch);
+
+				alignas(64) Type fr[chunkSize];
+				alignas(64) Type pts[numTaps][chunkSize];
+
+				for (size_t start = 0; start < n; start += chunkSize)
+				{
+					const size_t len = std::min(chunkSize, n - start);
+					const Type* del = delays + start;
+
+					for (size_t k = 0; k < len; ++k)
+					{
+						assert(del[k] >= 0 && static_cast<size_t>(del[k]) + numTaps <= maxSize);
+						// Signed conversion, the unsigned one is not a single instruction on x86.
+						const auto di = static_cast<int64_t>(del[k]);
+						const size_t idx = startPos + (start + k) * posStep - static_cast<size_t>(di);
+
+						fr[k] = del[k] - static_cast<Type>(di);
+						const Type* p = getOldest(src, idx);
+						for (size_t j = 0; j < numTaps; ++j) pts[j][k] = p[numTaps - 1 - j];
+					}
+
+					Type* out = dst + start;
+					if constexpr (numTaps == 1)
+						Op::evaluate(fr, pts[0], out, len);
+					else if constexpr (numTaps == 2)
+						Op::evaluate(fr, pts[0], pts[1], out, len);
+					else
+						Op::evaluate(fr, pts[0], pts[1], pts[2], pts[3], out, len);
+				}
+			}
+		}
+
+		/**
+		 * Interpolators are linear in their points, so a fixed frac gives FIR weights, oldest
+		 * point first. The sinc types take the kernel from their table.
+		 */
+		std::array<Type, numTaps> getWeights(double frac) const noexcept
+		{
+			if constexpr (numTaps == 1)
+			{
+				return { Type(1) };
+			}
+			else if constexpr (numTaps == 2)
+			{
+				return { op(frac, 0, 1), op(frac, 1, 0) };
+			}
+			else if constexpr (isSinc)
+			{
+				std::array<Type, numTaps> w;
+				op.getTable().getKernel(static_cast<Type>(frac), w.data());
+				return w;
+			}
+			else
+			{
+				return { op(frac, 0, 0, 0, 1), op(frac, 0, 0, 1, 0), op(frac, 0, 1, 0, 0), op(frac, 1, 0, 0, 0) };
+			}
+		}
+
 		//==============================================================================
 		Type interpolate(size_t ch, size_t del, double frac) const noexcept
 		{
@@ -86,6 +388,10 @@ namespace hexa
 
 				return op(frac, val1, val2);
 			}
+			else if constexpr (isSinc)
+			{
+				return op(frac, getOldest(buffer.col(ch), pos[ch] - del));
+			}
 			else
 			{
 				const size_t idx1 = (pos[ch] - del) & sizeMsk;
@@ -104,8 +410,10 @@ namespace hexa
 
 		//==============================================================================
 		size_t maxSize{}, sizeMsk{};
-		std::vector<size_t> pos{};
-		DataBuffer<Type, Alloc> buffer{};
+		std::vector<size_t, AllocFor<size_t>> pos{};
+		std::vector<uint8_t, AllocFor<uint8_t>> bypassed{};
+		SilenceGate<Type, AllocFor<size_t>> silence{};
+		Buffer buffer{};
 		Interpolator<Type, interp> op{};
 	};
 }
\ No newline at end of file
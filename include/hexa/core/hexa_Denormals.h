@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define HEXA_HAS_MXCSR 1
+	#include <xmmintrin.h>
+#endif
+
+// Library-wide default of DenormalMode, e.g. -DHEXA_DEFAULT_DENORMAL_MODE=flush.
+#if !defined(HEXA_DEFAULT_DENORMAL_MODE)
+	#define HEXA_DEFAULT_DENORMAL_MODE none
+#endif
+
+namespace hexa
+{
+	/**
+	 * How a processor keeps its recursive states out of the denormal range when the input
+	 * goes silent (denormal arithmetic is 10-100x slower on x86, and the states of a decaying
+	 * filter can get stuck there). Only the block entry points apply it, not processSample().
+	 */
+	enum class DenormalMode
+	{
+		none,		// nothing, e.g. the host sets FTZ/DAZ already
+		ftz,		// FTZ/DAZ (FZ on AArch64) set for the duration of every block
+		flush,		// states below 1e-15 set to 0 at the end of every block
+		offset		// +-1e-18 added to every input sample of a block, the sign alternates per block
+	};
+
+	//==============================================================================
+	/**
+	 * Sets FTZ/DAZ for its lifetime and restores the previous mode. Does nothing if they are
+	 * set already, so overlapping scopes (e.g. the stages of a Chain) can end in any order.
+	 * No-op on other targets.
+	 */
+	class ScopedNoDenormals
+	{
+	public:
+		explicit ScopedNoDenormals(bool enable = true) noexcept
+		{
+			if (!enable) return;
+
+#if defined(HEXA_HAS_MXCSR)
+			previous = _mm_getcsr();
+			active = (previous & 0x8040u) != 0x8040u;
+			if (active) _mm_setcsr(static_cast<unsigned int>(previous) | 0x8040u);	// FTZ | DAZ
+#elif defined(__aarch64__)
+			asm volatile("mrs %0, fpcr" : "=r"(previous));
+			active = (previous & (uint64_t(1) << 24)) == 0;
+			if (active) asm volatile("msr fpcr, %0" : : "r"(previous | (uint64_t(1) << 24)));	// FZ
+#endif
+		}
+
+		~ScopedNoDenormals()
+		{
+			if (!active) return;
+
+#if defined(HEXA_HAS_MXCSR)
+			_mm_setcsr(static_cast<unsigned int>(previous));
+#elif defined(__aarch64__)
+			asm volatile("msr fpcr, %0" : : "r"(previous));
+#endif
+		}
+
+		ScopedNoDenormals(const ScopedNoDenormals& other) = delete;
+		ScopedNoDenormals& operator= (const ScopedNoDenormals& other) = delete;
+
+		// The moved-from one restores nothing.
+		ScopedNoDenormals(ScopedNoDenormals&& other) noexcept
+			: active{ std::exchange(other.active, false) }, previous{ other.previous }
+		{
+		}
+
+		ScopedNoDenormals& operator= (ScopedNoDenormals&& other) = delete;
+
+	private:
+		bool active{};
+		uint64_t previous{};
+	};
+
+	//==============================================================================
+	/**
+	 * Applies a DenormalMode to the state vectors of a processor: process() opens a
+	 * protect(states...) scope and the mode is handled at its start and end.
+	 */
+	template <typename Type>
+	class DenormalProtection
+	{
+	public:
+		static constexpr Type flushThreshold = Type(1.e-15);
+		static constexpr Type offsetLevel = Type(1.e-18);
+
+		void setMode(DenormalMode newMode) noexcept { mode = newMode; }
+
+		DenormalMode getMode() const noexcept { return mode; }
+
+		//==============================================================================
+		template <typename... States>
+		class Scope
+		{
+		public:
+			Scope(DenormalProtection& owner, States&... s) noexcept
+				: noDenormals{ owner.mode == DenormalMode::ftz }, protection{ &owner }, states{ s... }
+			{
+				if (protection->mode != DenormalMode::offset) return;
+
+				protection->offsetSign = -protection->offsetSign;
+				protection->inputOffset = protection->offsetSign * offsetLevel;
+			}
+
+			~Scope()
+			{
+				if (protection == nullptr) return;
+
+				protection->inputOffset = 0;
+				if (protection->mode == DenormalMode::flush) std::apply([](auto&... v) { (flush(v), ...); }, states);
+			}
+
+			Scope(const Scope& other) = delete;
+			Scope& operator= (const Scope& other) = delete;
+
+			// Movable so a Chain can hold the scopes of its stages, the moved-from one does nothing.
+			Scope(Scope&& other) noexcept
+				: noDenormals{ std::move(other.noDenormals) }, protection{ std::exchange(other.protection, nullptr) }, states{ other.states }
+			{
+			}
+
+			Scope& operator= (Scope&& other) = delete;
+
+		private:
+			ScopedNoDenormals noDenormals;
+			DenormalProtection* protection;
+			std::tuple<States&...> states;
+		};
+
+		/**
+		 * Value the processing loops add to every input sample, non-zero only inside a scope
+		 * in offset mode. A steady excitation keeps the states above the denormal range however
+		 * fast they decay, an offset of the states once per block would not.
+		 */
+		Type getInputOffset() const noexcept { return inputOffset; }
+
+		/** Keep the returned scope alive for the whole block. */
+		template <typename... States>
+		Scope<States...> protect(States&... states) noexcept
+		{
+			return { *this, states... };
+		}
+
+		//==============================================================================
+		template <typename Alloc>
+		static void flush(std::vector<Type, Alloc>& states) noexcept
+		{
+			for (auto&& s : states) s = std::abs(s) < flushThreshold ? Type(0) : s;
+		}
+
+	private:
+		DenormalMode mode{ DenormalMode::HEXA_DEFAULT_DENORMAL_MODE };
+		Type offsetSign{ 1 }, inputOffset{};
+	};
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "hexa_General.h"
+#include "hexa_Simd.h"
+#include "../math/hexa_Constants.h"
+
+namespace hexa
+{
+	/**
+	 * Real FFT of a power of 2 size, in split complex form (separate re and im arrays of
+	 * size / 2 + 1 bins). The transform runs as a complex radix-2 FFT of half the size on
+	 * the even/odd samples, with per-stage contiguous twiddles so the butterflies of the
+	 * wider stages run in simd::Batch. inverse() is normalized, inverse(forward(x)) == x.
+	 */
+	template <typename Type>
+	class FFT
+	{
+	public:
+		explicit FFT(size_t newSize = 512)
+		{
+			resize(newSize);
+		}
+
+		void resize(size_t newSize)
+		{
+			assert(newSize >= 4 && (newSize & (newSize - 1)) == 0);
+			size = newSize;
+			half = size / 2;
+
+			// Bit reversal permutation of the half size transform.
+			bitRev.resize(half);
+			size_t numBits = 0;
+			while ((size_t(1) << numBits) < half) ++numBits;
+			for (size_t i = 0; i < half; ++i)
+			{
+				size_t r = 0;
+				for (size_t b = 0; b < numBits; ++b) r |= ((i >> b) & 1) << (numBits - 1 - b);
+				bitRev[i] = r;
+			}
+
+			// Twiddles of all stages back-to-back: the stage with span 2h starts at h - 1.
+			twRe.assign(half, Type(0));
+			twIm.assign(half, Type(0));
+			for (size_t h = 1; h < half; h *= 2)
+			{
+				for (size_t j = 0; j < h; ++j)
+				{
+					const double w = -c<double>::pi * double(j) / double(h);
+					twRe[h - 1 + j] = static_cast<Type>(std::cos(w));
+					twIm[h - 1 + j] = static_cast<Type>(std::sin(w));
+				}
+			}
+
+			// Split twiddles W^k = exp(-2 pi i k / size) of the real post-processing.
+			splitRe.resize(half + 1);
+			splitIm.resize(half + 1);
+			for (size_t k = 0; k <= half; ++k)
+			{
+				const double w = -c<double>::twoPi * double(k) / double(size);
+				splitRe[k] = static_cast<Type>(std::cos(w));
+				splitIm[k] = static_cast<Type>(std::sin(w));
+			}
+
+			workRe.resize(half);
+			workIm.resize(half);
+		}
+
+		//==============================================================================
+		size_t getSize() const noexcept { return size; }
+
+		size_t getNumBins() const noexcept { return half + 1; }
+
+		/** size real samples to getNumBins() bins. */
+		void forward(const Type* input, Type* re, Type* im) noexcept
+		{
+			Type* zr = workRe.data();
+			Type* zi = workIm.data();
+
+			for (size_t n = 0; n < half; ++n)
+			{
+				zr[bitRev[n]] = input[2 * n];
+				zi[bitRev[n]] = input[2 * n + 1];
+			}
+
+			butterflies(zr, zi);
+
+			// X[k] = E[k] + W^k O[k], with E and O the spectra of the even and odd samples.
+			re[0] = zr[0] + zi[0];
+			im[0] = 0;
+			re[half] = zr[0] - zi[0];
+			im[half] = 0;
+
+			for (size_t k = 1; k < half; ++k)
+			{
+				const Type ar = zr[k], ai = zi[k], br = zr[half - k], bi = -zi[half - k];
+				const Type er = (ar + br) / 2, ei = (ai + bi) / 2;
+				const Type orr = (ai - bi) / 2, oi = (br - ar) / 2;
+
+				re[k] = er + splitRe[k] * orr - splitIm[k] * oi;
+				im[k] = ei + splitRe[k] * oi + splitIm[k] * orr;
+			}
+		}
+
+		/** getNumBins() bins to size real samples, normalized. */
+		void inverse(const Type* re, const Type* im, Type* output) noexcept
+		{
+			Type* zr = workRe.data();
+			Type* zi = workIm.data();
+
+			// Z[k] = E[k] + i O[k], written bit reversed and with re/im swapped, so the
+			// forward butterflies compute the inverse transform.
+			for (size_t k = 0; k < half; ++k)
+			{
+				const Type ar = re[k], ai = im[k], br = re[half - k], bi = -im[half - k];
+				const Type er = (ar + br) / 2, ei = (ai + bi) / 2;
+				const Type dr = (ar - br) / 2, di = (ai - bi) / 2;
+				const Type orr = splitRe[k] * dr + splitIm[k] * di;
+				const Type oi = splitRe[k] * di - splitIm[k] * dr;
+
+				zi[bitRev[k]] = er - oi;
+				zr[bitRev[k]] = ei + orr;
+			}
+
+			butterflies(zr, zi);
+
+			const Type scale = Type(1) / Type(half);
+			for (size_t n = 0; n < half; ++n)
+			{
+				output[2 * n] = zi[n] * scale;
+				output[2 * n + 1] = zr[n] * scale;
+			}
+		}
+
+	private:
+		/** In-place radix-2 DIT on bit reversed input. */
+		void butterflies(Type* re, Type* im) noexcept
+		{
+			using Batch = simd::Batch<Type>;
+
+			for (size_t h = 1; h < half; h *= 2)
+			{
+				const Type* wr = twRe.data() + h - 1;
+				const Type* wi = twIm.data() + h - 1;
+
+				for (size_t start = 0; start < half; start += 2 * h)
+				{
+					Type* ar = re + start;
+					Type* ai = im + start;
+					Type* br = ar + h;
+					Type* bi = ai + h;
+
+					size_t j = 0;
+					if (h >= Batch::size)
+					{
+						for (; j < h; j += Batch::size)
+						{
+							const auto vwr = Batch::load(wr + j), vwi = Batch::load(wi + j);
+							const auto vbr = Batch::load(br + j), vbi = Batch::load(bi + j);
+							const auto var = Batch::load(ar + j), vai = Batch::load(ai + j);
+
+							const auto tr = vbr * vwr - vbi * vwi;
+							const auto ti = vbr * vwi + vbi * vwr;
+
+							(var + tr).store(ar + j);
+							(vai + ti).store(ai + j);
+							(var - tr).store(br + j);
+							(vai - ti).store(bi + j);
+						}
+					}
+
+					for (; j < h; ++j)
+					{
+						const Type tr = br[j] * wr[j] - bi[j] * wi[j];
+						const Type ti = br[j] * wi[j] + bi[j] * wr[j];
+
+						br[j] = ar[j] - tr;
+						bi[j] = ai[j] - ti;
+						ar[j] += tr;
+						ai[j] += ti;
+					}
+				}
+			}
+		}
+
+		//==============================================================================
+		size_t size{}, half{};
+		std::vector<size_t> bitRev;
+		std::vector<Type> twRe, twIm, splitRe, splitIm;
+		std::vector<Type> workRe, workIm;
+	};
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cmath>
+#include <cstdint>
 #include <limits>
+#include <ratio>
 #include <type_traits>
 
 namespace hexa::utils
@@ -67,6 +70,13 @@ namespace hexa::utils
 		return std::abs(value1 - value2) < std::numeric_limits<Type>::epsilon();
 	}
 
+	/** Value of a std::ratio, for compile-time parameters (C++17 has no floating-point template arguments). */
+	template <typename Ratio, typename Type = double>
+	constexpr Type ratioValue() noexcept
+	{
+		return static_cast<Type>(Ratio::num) / static_cast<Type>(Ratio::den);
+	}
+
 	// FNV-1a hash, 32-bit 
 	constexpr std::uint32_t fnv1a(const char* str, std::uint32_t hash = 2166136261UL)
 	{
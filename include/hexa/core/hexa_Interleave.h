@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace hexa
+{
+	namespace detail
+	{
+		// With the channel count known at compile time the frame loops below are turned into
+		// SIMD shuffles by the compiler (unpack/permute for 2 and 4 channels).
+		template <size_t NumChans, typename Type>
+		void interleaveFixed(const Type* const* planar, Type* __restrict interleaved, size_t numFrames) noexcept
+		{
+			const Type* src[NumChans];
+			std::copy_n(planar, NumChans, src);
+
+			for (size_t n = 0; n < numFrames; ++n)
+			{
+				for (size_t ch = 0; ch < NumChans; ++ch) interleaved[n * NumChans + ch] = src[ch][n];
+			}
+		}
+
+		template <size_t NumChans, typename Type>
+		void deinterleaveFixed(const Type* __restrict interleaved, Type* const* planar, size_t numFrames) noexcept
+		{
+			Type* dst[NumChans];
+			std::copy_n(planar, NumChans, dst);
+
+			if constexpr (NumChans == 6)
+			{
+				// Six doesn't divide the vector width, strided reads per channel do best here.
+				for (size_t ch = 0; ch < NumChans; ++ch)
+				{
+					const Type* src = interleaved + ch;
+					Type* __restrict out = dst[ch];
+					for (size_t n = 0; n < numFrames; ++n) out[n] = src[n * NumChans];
+				}
+			}
+			else if constexpr (NumChans <= 4)
+			{
+				for (size_t n = 0; n < numFrames; ++n)
+				{
+					for (size_t ch = 0; ch < NumChans; ++ch) dst[ch][n] = interleaved[n * NumChans + ch];
+				}
+			}
+			else
+			{
+				// Wider frames go through a small tile, so both the reads and the writes stay
+				// contiguous runs.
+				constexpr size_t tileSize = 16;
+				Type tile[NumChans][tileSize];
+
+				size_t n = 0;
+				for (; n + tileSize <= numFrames; n += tileSize)
+				{
+					const Type* src = interleaved + n * NumChans;
+					for (size_t k = 0; k < tileSize; ++k)
+					{
+						for (size_t ch = 0; ch < NumChans; ++ch) tile[ch][k] = src[k * NumChans + ch];
+					}
+
+					for (size_t ch = 0; ch < NumChans; ++ch) std::copy_n(tile[ch], tileSize, dst[ch] + n);
+				}
+
+				for (; n < numFrames; ++n)
+				{
+					for (size_t ch = 0; ch < NumChans; ++ch) dst[ch][n] = interleaved[n * NumChans + ch];
+				}
+			}
+		}
+	}
+
+	//==============================================================================
+	/** Planar channels to interleaved frames, with dedicated kernels for 1, 2, 4, 6 and 8 channels. */
+	template <typename Type>
+	void interleave(const Type* const* planar, Type* interleaved, size_t numChannels, size_t numFrames) noexcept
+	{
+		switch (numChannels)
+		{
+		case 1: std::copy_n(planar[0], numFrames, interleaved); break;
+		case 2: detail::interleaveFixed<2>(planar, interleaved, numFrames); break;
+		case 4: detail::interleaveFixed<4>(planar, interleaved, numFrames); break;
+		case 6: detail::interleaveFixed<6>(planar, interleaved, numFrames); break;
+		case 8: detail::interleaveFixed<8>(planar, interleaved, numFrames); break;
+		default:
+			for (size_t ch = 0; ch < numChannels; ++ch)
+			{
+				const Type* src = planar[ch];
+				for (size_t n = 0; n < numFrames; ++n) interleaved[n * numChannels + ch] = src[n];
+			}
+		}
+	}
+
+	/** Interleaved frames to planar channels, with dedicated kernels for 1, 2, 4, 6 and 8 channels. */
+	template <typename Type>
+	void deinterleave(const Type* interleaved, Type* const* planar, size_t numChannels, size_t numFrames) noexcept
+	{
+		switch (numChannels)
+		{
+		case 1: std::copy_n(interleaved, numFrames, planar[0]); break;
+		case 2: detail::deinterleaveFixed<2>(interleaved, planar, numFrames); break;
+		case 4: detail::deinterleaveFixed<4>(interleaved, planar, numFrames); break;
+		case 6: detail::deinterleaveFixed<6>(interleaved, planar, numFrames); break;
+		case 8: detail::deinterleaveFixed<8>(interleaved, planar, numFrames); break;
+		default:
+			for (size_t ch = 0; ch < numChannels; ++ch)
+			{
+				Type* dst = planar[ch];
+				for (size_t n = 0; n < numFrames; ++n) dst[n] = interleaved[n * numChannels + ch];
+			}
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "hexa_ThreadPool.h"
+
+namespace hexa
+{
+	/**
+	 * Runs any hexa processor over many independent channels on a ThreadPool. The channels
+	 * are split into groups sized so a group's input and output block fit in the L1 cache
+	 * (or setChannelsPerTask()), every group is a processor instance of its own and one pool
+	 * task. Parameters go to all instances through forEach(), after prepare().
+	 *
+	 * @code
+	 *	hexa::ThreadPool pool;
+	 *	hexa::ParallelProcessor<hexa::RBJFilter<float>> bank(pool);
+	 *	bank.prepare(48000.f, 256, 512);
+	 *	bank.forEach([](auto& f) { f.setCutoff(800.f); });
+	 *	bank.process(inputs, outputs, 256, 512);
+	 * @endcode
+	 */
+	template <typename Proc>
+	class ParallelProcessor final
+	{
+	public:
+		explicit ParallelProcessor(ThreadPool& threadPool) noexcept : pool(threadPool) {}
+
+		//==============================================================================
+		/** Fixed group size instead of the cache-based one, takes effect on the next prepare(). */
+		void setChannelsPerTask(size_t numChannelsPerTask) noexcept { requestedGroupSize = numChannelsPerTask; }
+
+		size_t getChannelsPerTask() const noexcept { return groupSize; }
+
+		size_t getNumTasks() const noexcept { return groups.size(); }
+
+		template <typename Fn>
+		void forEach(Fn&& fn)
+		{
+			for (auto&& proc : groups) fn(proc);
+		}
+
+		//==============================================================================
+		template <typename Type>
+		void prepare(Type sRate, size_t numChannels, size_t maxBlockSize)
+		{
+			groupSize = requestedGroupSize;
+			if (groupSize == 0)
+			{
+				const size_t bytesPerChannel = 2 * std::max<size_t>(maxBlockSize, 1) * sizeof(Type);
+				groupSize = std::max<size_t>(l1Bytes / bytesPerChannel, 1);
+			}
+
+			const size_t numGroups = (numChannels + groupSize - 1) / groupSize;
+			groups.clear();
+			groups.resize(numGroups);
+
+			for (size_t g = 0; g < numGroups; ++g)
+			{
+				groups[g].prepare(sRate, std::min(groupSize, numChannels - g * groupSize), maxBlockSize);
+			}
+		}
+
+		template <typename Type>
+		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
+		{
+			const size_t numTasks = (nChans + groupSize - 1) / groupSize;
+			assert(numTasks <= groups.size());
+
+			pool.parallelFor(numTasks, [&](size_t g)
+			{
+				const size_t first = g * groupSize;
+				groups[g].process(inputs + first, outputs + first, std::min(groupSize, nChans - first), nFrames);
+			});
+		}
+
+		void reset() noexcept
+		{
+			for (auto&& proc : groups) proc.reset();
+		}
+
+	private:
+		static constexpr size_t l1Bytes = 32 * 1024;
+
+		ThreadPool& pool;
+		std::vector<Proc> groups;
+		size_t requestedGroupSize{}, groupSize{ 1 };
+	};
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hexa
+{
+	/**
+	 * Lock-free parameter changes (id, value) from one control thread to the audio thread.
+	 * Every parameter has one slot that holds its latest value, the control thread push()es
+	 * into it, the audio thread drain()s at the start of a block and gets only the latest
+	 * value of every changed parameter, so a burst of automation costs one coefficient
+	 * update and the final value of a burst is never lost. No locks and no allocations on
+	 * either side.
+	 */
+	template <typename Type, size_t NumParameters>
+	class ParameterQueue
+	{
+		static_assert(NumParameters > 0, "ParameterQueue needs at least one parameter");
+		static_assert(std::atomic<Type>::is_always_lock_free, "ParameterQueue needs lock-free atomics of Type");
+
+	public:
+		ParameterQueue() = default;
+
+		// Copies are meant for setup (e.g. a processor moved into a container), not for a
+		// queue in use.
+		ParameterQueue(const ParameterQueue& other) noexcept { *this = other; }
+
+		ParameterQueue& operator= (const ParameterQueue& other) noexcept
+		{
+			for (size_t id = 0; id < NumParameters; ++id)
+			{
+				values[id].store(other.values[id].load(std::memory_order_relaxed), std::memory_order_relaxed);
+				changed[id].store(other.changed[id].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+			anyChanged.store(other.anyChanged.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			return *this;
+		}
+
+		//==============================================================================
+		/** Control thread. Replaces a change of id that is still waiting. */
+		void push(size_t id, Type value) noexcept
+		{
+			if (id >= NumParameters) return;
+
+			values[id].store(value, std::memory_order_relaxed);
+			changed[id].store(true, std::memory_order_release);
+			anyChanged.store(true, std::memory_order_release);
+		}
+
+		/**
+		 * Audio thread. Calls apply(id, value) once per changed parameter, with its latest value
+		 * and in id order. Returns true if anything was applied.
+		 */
+		template <typename Fn>
+		bool drain(Fn&& apply) noexcept
+		{
+			if (!anyChanged.exchange(false, std::memory_order_acquire)) return false;
+
+			// A value pushed while this runs is either picked up now or flags the next drain
+			// (and may be applied twice, which is harmless).
+			bool applied = false;
+			for (size_t id = 0; id < NumParameters; ++id)
+			{
+				if (!changed[id].exchange(false, std::memory_order_acquire)) continue;
+				apply(id, values[id].load(std::memory_order_relaxed));
+				applied = true;
+			}
+			return applied;
+		}
+
+		/**
+		 * Audio thread (or setup while no block runs). Removes the waiting change of id, if
+		 * any, into value. Returns false if there was none.
+		 */
+		bool take(size_t id, Type& value) noexcept
+		{
+			if (id >= NumParameters || !changed[id].exchange(false, std::memory_order_acquire)) return false;
+
+			value = values[id].load(std::memory_order_relaxed);
+			return true;
+		}
+
+		/** Number of parameters with a change waiting, exact on the audio thread only. */
+		size_t getNumPending() const noexcept
+		{
+			size_t num = 0;
+			for (const auto& c : changed) num += c.load(std::memory_order_acquire) ? 1 : 0;
+			return num;
+		}
+
+	private:
+		std::array<std::atomic<Type>, NumParameters> values{};
+		std::array<std::atomic<bool>, NumParameters> changed{};
+
+		// On its own cache line, the audio thread polls it every block.
+		alignas(64) std::atomic<bool> anyChanged{ false };
+	};
+
+	//==============================================================================
+	/**
+	 * Lock-free handover of a value too large for a ParameterQueue (e.g. a table), from one
+	 * control thread to the audio thread. The control thread fills getWriteBuffer() (it may
+	 * allocate there) and publish()es it, the audio thread acquire()s the latest published
+	 * one. Three buffers, so neither side waits and nothing is freed on the audio thread.
+	 */
+	template <typename T>
+	class TripleBuffer
+	{
+	public:
+		TripleBuffer() = default;
+
+		// Copies are meant for setup, not for a buffer in use.
+		TripleBuffer(const TripleBuffer& other) { *this = other; }
+
+		TripleBuffer& operator= (const TripleBuffer& other)
+		{
+			buffers = other.buffers;
+			front = other.front;
+			back = other.back;
+			middle.store(other.middle.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			return *this;
+		}
+
+		//==============================================================================
+		/** Control thread. The buffer to fill before publish(). */
+		T& getWriteBuffer() noexcept { return buffers[back]; }
+
+		/** Control thread. Hands the write buffer over, it replaces a value not acquired yet. */
+		void publish() noexcept
+		{
+			back = middle.exchange(back | fresh, std::memory_order_acq_rel) & indexMask;
+		}
+
+		/** Audio thread. Switches to the latest published value, true if there was one. */
+		bool acquire() noexcept
+		{
+			if ((middle.load(std::memory_order_relaxed) & fresh) == 0) return false;
+
+			front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+			return true;
+		}
+
+		/** Audio thread (or setup). */
+		T& getReadBuffer() noexcept { return buffers[front]; }
+
+		const T& getReadBuffer() const noexcept { return buffers[front]; }
+
+		/** Drops a published value that was not acquired yet, setup only. */
+		void clearPending() noexcept
+		{
+			middle.fetch_and(indexMask, std::memory_order_relaxed);
+		}
+
+	private:
+		static constexpr uint32_t indexMask = 3, fresh = 4;
+
+		std::array<T, 3> buffers{};
+		uint32_t front{ 0 }, back{ 1 };
+		alignas(64) std::atomic<uint32_t> middle{ 2 };
+	};
+}
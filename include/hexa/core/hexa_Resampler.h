@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "hexa_DataBuffer.h"
+#include "../math/hexa_Interpolators.h"
+#include "../math/hexa_Sinc.h"
+
+namespace hexa
+{
+	/**
+	 * Streaming sample rate converter with an arbitrary, optionally time-varying ratio
+	 * (output rate / input rate). The polynomial interpolation types are cheap and alias
+	 * (use them for small ratio changes or oversampled signals), the sinc types run a
+	 * polyphase FIR that is cut off at the lower of both Nyquist frequencies given to
+	 * prepare(). The input history stays contiguous in a DataBuffer, so every output reads
+	 * its points in place. Nothing allocates after prepare().
+	 */
+	template <typename Type, InterpolationType interp = InterpolationType::Sinc32, typename Alloc = std::allocator<Type>>
+	class Resampler
+	{
+	public:
+		//==============================================================================
+		Resampler() = default;
+
+		Resampler(const Resampler& other) = delete;
+		Resampler& operator= (const Resampler& other) = delete;
+
+		Resampler(Resampler&& other) = default;
+		Resampler& operator= (Resampler&& other) = default;
+
+		//==============================================================================
+		/** Phases per sample of the sinc table, applied by the next prepare(). No effect for the polynomial types. */
+		void setSincPhases(size_t numPhases) noexcept
+		{
+			assert(numPhases > 0);
+			sincPhases = numPhases;
+		}
+
+		/**
+		 * Builds the tables and buffers for the rates and the largest block of input frames
+		 * (push) or output frames (pull) of a call. Allocates.
+		 */
+		void prepare(double inputRate, double outputRate, size_t numChannels, size_t maxBlockSize)
+		{
+			assert(inputRate > 0 && outputRate > 0 && maxBlockSize > 0);
+			setRatio(outputRate / inputRate);
+
+			if constexpr (isSinc) table = SincTable<Type>::get(numPoints, sincPhases, std::min(1., ratio));
+
+			capacity = maxBlockSize + 2 * numPoints;
+			history.resize(capacity, numChannels);
+			inPtrs.resize(numChannels);
+
+			reset();
+		}
+
+		void reset() noexcept
+		{
+			history.clear();
+
+			// Zeros stand in for the samples before the first input.
+			filled = numPoints - 1;
+			time = double(centre);
+		}
+
+		//==============================================================================
+		/**
+		 * Output rate / input rate, from the next output sample on. Call it between blocks for
+		 * a time-varying ratio. The sinc cutoff stays at the one of prepare(), so downsampling
+		 * further than prepared aliases.
+		 */
+		void setRatio(double newRatio) noexcept
+		{
+			assert(newRatio > 0);
+			ratio = newRatio;
+			step = 1. / newRatio;
+		}
+
+		double getRatio() const noexcept { return ratio; }
+
+		/** Delay of the output in input samples, the points the interpolation looks ahead. */
+		size_t getInputLatency() const noexcept { return numPoints - 1 - centre; }
+
+		/** Delay of the output in output samples at the current ratio. */
+		double getLatencyInSamples() const noexcept { return double(getInputLatency()) * ratio; }
+
+		/** Upper bound of the frames push() writes for numInputFrames. */
+		size_t getMaxOutputFrames(size_t numInputFrames) const noexcept
+		{
+			return static_cast<size_t>(std::ceil(double(numInputFrames) * ratio)) + 1;
+		}
+
+		/** Input frames the next numOutputFrames need, push() them to get exactly that many. */
+		size_t getInputFramesNeeded(size_t numOutputFrames) const noexcept
+		{
+			if (numOutputFrames == 0) return 0;
+
+			const double last = time + double(numOutputFrames - 1) * step;
+			const int64_t needed = static_cast<int64_t>(std::floor(last)) - int64_t(centre) + int64_t(numPoints) - int64_t(filled);
+			return static_cast<size_t>(std::max(needed, int64_t(0)));
+		}
+
+		//==============================================================================
+		/** Consumes nFrames input frames and returns the number of frames written to outputs, see getMaxOutputFrames(). */
+		size_t push(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
+		{
+			assert(nChans <= inPtrs.size());
+
+			size_t numOut = 0;
+			for (size_t start = 0; start < nFrames;)
+			{
+				const size_t len = std::min(nFrames - start, capacity - filled);
+				for (size_t ch = 0; ch < nChans; ++ch) std::copy_n(inputs[ch] + start, len, history.col(ch) + filled);
+				filled += len;
+				start += len;
+
+				numOut += render(outputs, nChans, numOut, size_t(-1));
+				compact();
+			}
+
+			return numOut;
+		}
+
+		/**
+		 * Writes exactly nFrames output frames and asks source(Type** dst, size_t n) for the
+		 * input on the way, it fills n frames of the nChans channels at dst.
+		 */
+		template <typename Source>
+		void pull(Type** outputs, size_t nChans, size_t nFrames, Source&& source)
+		{
+			assert(nChans <= inPtrs.size());
+
+			for (size_t done = 0; done < nFrames;)
+			{
+				const size_t len = std::min(getInputFramesNeeded(nFrames - done), capacity - filled);
+				if (len > 0)
+				{
+					for (size_t ch = 0; ch < nChans; ++ch) inPtrs[ch] = history.col(ch) + filled;
+					source(inPtrs.data(), len);
+					filled += len;
+				}
+
+				done += render(outputs, nChans, done, nFrames - done);
+				compact();
+			}
+		}
+
+	private:
+		static constexpr size_t numPoints = Interpolator<Type, interp>::numPoints;
+		static constexpr bool isSinc = isSincInterpolation(interp);
+		static constexpr size_t chunkSize = 64;
+
+		// Every output at time t reads the numPoints points from floor(t) - centre on.
+		static constexpr size_t centre = (numPoints - 1) / 2;
+
+		//==============================================================================
+		/** Writes the outputs the history holds the points of (at most maxFrames) from outputs[ch] + offset on. */
+		size_t render(Type** outputs, size_t nChans, size_t offset, size_t maxFrames) noexcept
+		{
+			const size_t numFrames = std::min(maxFrames, getNumAvailable());
+
+			alignas(64) Type fr[chunkSize];
+			size_t idx[chunkSize];
+
+			for (size_t start = 0; start < numFrames; start += chunkSize)
+			{
+				const size_t len = std::min(chunkSize, numFrames - start);
+				for (size_t k = 0; k < len; ++k)
+				{
+					const double t = time + double(start + k) * step;
+					const double ti = std::floor(t);
+
+					idx[k] = static_cast<size_t>(ti) - centre;
+					// The sinc fraction counts back from the next point, like a delay.
+					fr[k] = static_cast<Type>(isSinc ? 1 - (t - ti) : t - ti);
+				}
+
+				for (size_t ch = 0; ch < nChans; ++ch) interpolate(history.col(ch), idx, fr, outputs[ch] + offset + start, len);
+			}
+
+			time += double(numFrames) * step;
+			return numFrames;
+		}
+
+		/** Number of outputs whose points are all in the history. */
+		size_t getNumAvailable() const noexcept
+		{
+			// Output k is available while floor(time + k * step) <= last.
+			const double last = double(filled + centre) - double(numPoints);
+			if (time >= last + 1) return 0;
+
+			auto isAvailable = [&](size_t k) { return std::floor(time + double(k) * step) <= last; };
+
+			size_t num = static_cast<size_t>((last + 1 - time) / step) + 1;
+			while (num > 0 && !isAvailable(num - 1)) --num;
+			while (isAvailable(num)) ++num;
+			return num;
+		}
+
+		void interpolate(const Type* src, const size_t* idx, const Type* fr, Type* dst, size_t n) const noexcept
+		{
+			if constexpr (isSinc)
+			{
+				const auto& kernels = *table;
+				for (size_t k = 0; k < n; ++k) dst[k] = kernels.dot(fr[k], src + idx[k]);
+			}
+			else
+			{
+				using Op = Interpolator<Type, interp>;
+
+				alignas(64) Type pts[numPoints][chunkSize];
+				for (size_t k = 0; k < n; ++k)
+				{
+					for (size_t j = 0; j < numPoints; ++j) pts[j][k] = src[idx[k] + j];
+				}
+
+				// Points in time order, Linear takes the later one first.
+				if constexpr (numPoints == 1)
+					Op::evaluate(fr, pts[0], dst, n);
+				else if constexpr (numPoints == 2)
+					Op::evaluate(fr, pts[1], pts[0], dst, n);
+				else
+					Op::evaluate(fr, pts[0], pts[1], pts[2], pts[3], dst, n);
+			}
+		}
+
+		/** Drops the input the next output does not read anymore, in all channels to keep them in step. */
+		void compact() noexcept
+		{
+			const auto first = static_cast<size_t>(std::floor(time)) - centre;
+			const size_t num = std::min(first, filled);
+			if (num == 0) return;
+
+			for (size_t ch = 0; ch < history.getNumCols(); ++ch)
+			{
+				Type* h = history.col(ch);
+				std::copy(h + num, h + filled, h);
+			}
+
+			filled -= num;
+			time -= double(num);
+		}
+
+		//==============================================================================
+		double ratio{ 1. }, step{ 1. }, time{ double(centre) };
+		size_t sincPhases{ SincInterpolator<Type, 8>::defaultNumPhases };
+		size_t capacity{}, filled{};
+
+		std::shared_ptr<const SincTable<Type>> table{};
+		DataBuffer<Type, Alloc, AlignedStorage<64>> history{ 1, 1 };
+		std::vector<Type*> inPtrs{};
+	};
+}
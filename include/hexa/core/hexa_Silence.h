@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "hexa_Simd.h"
+
+namespace hexa
+{
+	namespace silence
+	{
+		/** Level at or below which an input block counts as silent, -160 dB. */
+		template <typename Type>
+		inline constexpr Type defaultThreshold = Type(1.e-8);
+
+		/** Decay the tail lengths are measured to, -120 dB. */
+		template <typename Type>
+		inline constexpr Type tailDecay = Type(1.e-6);
+
+		/** Tail of an unstable or marginally stable system, its channels are never skipped. */
+		inline constexpr size_t infiniteTail = std::numeric_limits<size_t>::max();
+
+		/** true if |x[n]| <= threshold for all n, it stops at the first chunk that is not. */
+		template <typename Type>
+		bool isSilent(const Type* x, size_t n, Type threshold) noexcept
+		{
+			using Batch = simd::Batch<Type>;
+			constexpr size_t chunkSize = 8 * Batch::size;
+
+			const auto vThreshold = Batch::broadcast(threshold);
+			alignas(64) Type lanes[Batch::size];
+
+			size_t i = 0;
+			for (; i + chunkSize <= n; i += chunkSize)
+			{
+				auto peak = Batch::broadcast(Type(0));
+				for (size_t k = 0; k < chunkSize; k += Batch::size)
+				{
+					const auto v = Batch::load(x + i + k);
+					peak = max(peak, max(v, -v));
+				}
+
+				selectIfGreater(peak, vThreshold, Batch::broadcast(Type(1)), Batch::broadcast(Type(0))).store(lanes);
+				for (size_t l = 0; l < Batch::size; ++l)
+				{
+					if (lanes[l] != Type(0)) return false;
+				}
+			}
+
+			for (; i < n; ++i)
+			{
+				if (std::abs(x[i]) > threshold) return false;
+			}
+
+			return true;
+		}
+
+		/** Samples for a pole of the given radius to decay by tailDecay. */
+		template <typename Type>
+		size_t tailFromPoleRadius(Type radius) noexcept
+		{
+			if (!(radius < Type(1))) return infiniteTail;
+			if (radius <= std::numeric_limits<Type>::min()) return 0;
+
+			return static_cast<size_t>(std::ceil(std::log(tailDecay<Type>) / std::log(radius)));
+		}
+	}
+
+	//==============================================================================
+	/**
+	 * Per channel silence tracking for the block entry points of a processor. A channel can
+	 * skip a block once its input has been silent for the processor's tail length, as the
+	 * states have decayed below the tail decay by then. The processor zeroes the output and
+	 * the states of a skipped channel, so the next signal starts from a clean state.
+	 * Silent means every sample at or below the threshold. Off by default.
+	 */
+	template <typename Type, typename Alloc = std::allocator<size_t>>
+	class SilenceGate
+	{
+	public:
+		void setEnabled(bool shouldBeEnabled) noexcept { enabled = shouldBeEnabled; }
+
+		bool isEnabled() const noexcept { return enabled; }
+
+		void setThreshold(Type newThreshold) noexcept { threshold = newThreshold; }
+
+		Type getThreshold() const noexcept { return threshold; }
+
+		//==============================================================================
+		void prepare(size_t numChannels)
+		{
+			silentFor.assign(numChannels, 0);
+		}
+
+		void reset() noexcept
+		{
+			std::fill(silentFor.begin(), silentFor.end(), size_t(0));
+		}
+
+		/** Starts the silence count of channel ch over, for samples that went past canSkip(). */
+		void restart(size_t ch) noexcept
+		{
+			silentFor[ch] = 0;
+		}
+
+		/** Call once per channel and block, true if the block of channel ch can be skipped. */
+		bool canSkip(size_t ch, const Type* input, size_t nFrames, size_t tailLength) noexcept
+		{
+			if (!enabled) return false;
+
+			auto&& count = silentFor[ch];
+			if (!silence::isSilent(input, nFrames, threshold))
+			{
+				count = 0;
+				return false;
+			}
+
+			const bool settled = count >= tailLength;
+			count = std::min(count + nFrames, tailLength);
+			return settled;
+		}
+
+		/** canSkip() of the channels first ... first + num - 1, true only if all of them can skip. */
+		bool canSkipAll(size_t first, size_t num, const Type** inputs, size_t nFrames, size_t tailLength) noexcept
+		{
+			bool all = true;
+			for (size_t ch = first; ch < first + num; ++ch) all = canSkip(ch, inputs[ch], nFrames, tailLength) && all;
+			return all;
+		}
+
+	private:
+		bool enabled{};
+		Type threshold{ silence::defaultThreshold<Type> };
+
+		std::vector<size_t, Alloc> silentFor{};
+	};
+}
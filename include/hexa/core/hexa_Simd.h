@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+// Define HEXA_NO_SIMD to force the scalar fallback on any target.
+#if !defined(HEXA_NO_SIMD)
+	#if defined(__AVX__)
+		#define HEXA_SIMD_AVX 1
+		#include <immintrin.h>
+	#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define HEXA_SIMD_SSE2 1
+		#include <emmintrin.h>
+	#endif
+#endif
+
+namespace hexa::simd
+{
+	/**
+	 * A thin wrapper over a native SIMD register. The primary template is a one lane
+	 * scalar fallback, so every kernel written with Batch also compiles for long double
+	 * or on targets without SSE/AVX.
+	 */
+	template <typename Type>
+	struct Batch
+	{
+		static constexpr size_t size = 1;
+
+		Type v{};
+
+		Batch() = default;
+
+		Batch(Type x) noexcept : v(x) {}
+
+		//==============================================================================
+		static Batch load(const Type* src) noexcept { return { *src }; }
+
+		static Batch broadcast(Type x) noexcept { return { x }; }
+
+		void store(Type* dst) const noexcept { *dst = v; }
+
+		//==============================================================================
+		friend Batch operator- (Batch a) noexcept { return { -a.v }; }
+
+		friend Batch operator+ (Batch a, Batch b) noexcept { return { a.v + b.v }; }
+
+		friend Batch operator- (Batch a, Batch b) noexcept { return { a.v - b.v }; }
+
+		friend Batch operator* (Batch a, Batch b) noexcept { return { a.v * b.v }; }
+
+		friend Batch operator/ (Batch a, Batch b) noexcept { return { a.v / b.v }; }
+
+		//==============================================================================
+		friend Batch min(Batch a, Batch b) noexcept { return { b.v < a.v ? b.v : a.v }; }
+
+		friend Batch max(Batch a, Batch b) noexcept { return { a.v < b.v ? b.v : a.v }; }
+
+		friend Batch sqrt(Batch a) noexcept { return { std::sqrt(a.v) }; }
+
+		/** Lane-wise a > b ? ifTrue : ifFalse. */
+		friend Batch selectIfGreater(Batch a, Batch b, Batch ifTrue, Batch ifFalse) noexcept
+		{
+			return { a.v > b.v ? ifTrue.v : ifFalse.v };
+		}
+	};
+
+#if defined(HEXA_SIMD_AVX)
+	template <>
+	struct Batch<float>
+	{
+		static constexpr size_t size = 8;
+
+		__m256 v;
+
+		Batch() = default;
+
+		Batch(__m256 r) noexcept : v(r) {}
+
+		/** Broadcasts a scalar, so generic code like hexa::pade works on batches too. */
+		Batch(float x) noexcept : v(_mm256_set1_ps(x)) {}
+
+		//==============================================================================
+		static Batch load(const float* src) noexcept { return { _mm256_loadu_ps(src) }; }
+
+		static Batch broadcast(float x) noexcept { return { _mm256_set1_ps(x) }; }
+
+		void store(float* dst) const noexcept { _mm256_storeu_ps(dst, v); }
+
+		//==============================================================================
+		friend Batch operator- (Batch a) noexcept { return { _mm256_xor_ps(a.v, _mm256_set1_ps(-0.f)) }; }
+
+		friend Batch operator+ (Batch a, Batch b) noexcept { return { _mm256_add_ps(a.v, b.v) }; }
+
+		friend Batch operator- (Batch a, Batch b) noexcept { return { _mm256_sub_ps(a.v, b.v) }; }
+
+		friend Batch operator* (Batch a, Batch b) noexcept { return { _mm256_mul_ps(a.v, b.v) }; }
+
+		friend Batch operator/ (Batch a, Batch b) noexcept { return { _mm256_div_ps(a.v, b.v) }; }
+
+		//==============================================================================
+		friend Batch min(Batch a, Batch b) noexcept { return { _mm256_min_ps(a.v, b.v) }; }
+
+		friend Batch max(Batch a, Batch b) noexcept { return { _mm256_max_ps(a.v, b.v) }; }
+
+		friend Batch sqrt(Batch a) noexcept { return { _mm256_sqrt_ps(a.v) }; }
+
+		/** Lane-wise a > b ? ifTrue : ifFalse. */
+		friend Batch selectIfGreater(Batch a, Batch b, Batch ifTrue, Batch ifFalse) noexcept
+		{
+			return { _mm256_blendv_ps(ifFalse.v, ifTrue.v, _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)) };
+		}
+	};
+
+	template <>
+	struct Batch<double>
+	{
+		static constexpr size_t size = 4;
+
+		__m256d v;
+
+		Batch() = default;
+
+		Batch(__m256d r) noexcept : v(r) {}
+
+		/** Broadcasts a scalar, so generic code like hexa::pade works on batches too. */
+		Batch(double x) noexcept : v(_mm256_set1_pd(x)) {}
+
+		//==============================================================================
+		static Batch load(const double* src) noexcept { return { _mm256_loadu_pd(src) }; }
+
+		static Batch broadcast(double x) noexcept { return { _mm256_set1_pd(x) }; }
+
+		void store(double* dst) const noexcept { _mm256_storeu_pd(dst, v); }
+
+		//==============================================================================
+		friend Batch operator- (Batch a) noexcept { return { _mm256_xor_pd(a.v, _mm256_set1_pd(-0.)) }; }
+
+		friend Batch operator+ (Batch a, Batch b) noexcept { return { _mm256_add_pd(a.v, b.v) }; }
+
+		friend Batch operator- (Batch a, Batch b) noexcept { return { _mm256_sub_pd(a.v, b.v) }; }
+
+		friend Batch operator* (Batch a, Batch b) noexcept { return { _mm256_mul_pd(a.v, b.v) }; }
+
+		friend Batch operator/ (Batch a, Batch b) noexcept { return { _mm256_div_pd(a.v, b.v) }; }
+
+		//==============================================================================
+		friend Batch min(Batch a, Batch b) noexcept { return { _mm256_min_pd(a.v, b.v) }; }
+
+		friend Batch max(Batch a, Batch b) noexcept { return { _mm256_max_pd(a.v, b.v) }; }
+
+		friend Batch sqrt(Batch a) noexcept { return { _mm256_sqrt_pd(a.v) }; }
+
+		/** Lane-wise a > b ? ifTrue : ifFalse. */
+		friend Batch selectIfGreater(Batch a, Batch b, Batch ifTrue, Batch ifFalse) noexcept
+		{
+			return { _mm256_blendv_pd(ifFalse.v, ifTrue.v, _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)) };
+		}
+	};
+#elif defined(HEXA_SIMD_SSE2)
+	template <>
+	struct Batch<float>
+	{
+		static constexpr size_t size = 4;
+
+		__m128 v;
+
+		Batch() = default;
+
+		Batch(__m128 r) noexcept : v(r) {}
+
+		/** Broadcasts a scalar, so generic code like hexa::pade works on batches too. */
+		Batch(float x) noexcept : v(_mm_set1_ps(x)) {}
+
+		//==============================================================================
+		static Batch load(const float* src) noexcept { return { _mm_loadu_ps(src) }; }
+
+		static Batch broadcast(float x) noexcept { return { _mm_set1_ps(x) }; }
+
+		void store(float* dst) const noexcept { _mm_storeu_ps(dst, v); }
+
+		//==============================================================================
+		friend Batch operator- (Batch a) noexcept { return { _mm_xor_ps(a.v, _mm_set1_ps(-0.f)) }; }
+
+		friend Batch operator+ (Batch a, Batch b) noexcept { return { _mm_add_ps(a.v, b.v) }; }
+
+		friend Batch operator- (Batch a, Batch b) noexcept { return { _mm_sub_ps(a.v, b.v) }; }
+
+		friend Batch operator* (Batch a, Batch b) noexcept { return { _mm_mul_ps(a.v, b.v) }; }
+
+		friend Batch operator/ (Batch a, Batch b) noexcept { return { _mm_div_ps(a.v, b.v) }; }
+
+		//==============================================================================
+		friend Batch min(Batch a, Batch b) noexcept { return { _mm_min_ps(a.v, b.v) }; }
+
+		friend Batch max(Batch a, Batch b) noexcept { return { _mm_max_ps(a.v, b.v) }; }
+
+		friend Batch sqrt(Batch a) noexcept { return { _mm_sqrt_ps(a.v) }; }
+
+		/** Lane-wise a > b ? ifTrue : ifFalse. */
+		friend Batch selectIfGreater(Batch a, Batch b, Batch ifTrue, Batch ifFalse) noexcept
+		{
+			const __m128 mask = _mm_cmpgt_ps(a.v, b.v);
+			return { _mm_or_ps(_mm_and_ps(mask, ifTrue.v), _mm_andnot_ps(mask, ifFalse.v)) };
+		}
+	};
+
+	template <>
+	struct Batch<double>
+	{
+		static constexpr size_t size = 2;
+
+		__m128d v;
+
+		Batch() = default;
+
+		Batch(__m128d r) noexcept : v(r) {}
+
+		/** Broadcasts a scalar, so generic code like hexa::pade works on batches too. */
+		Batch(double x) noexcept : v(_mm_set1_pd(x)) {}
+
+		//==============================================================================
+		static Batch load(const double* src) noexcept { return { _mm_loadu_pd(src) }; }
+
+		static Batch broadcast(double x) noexcept { return { _mm_set1_pd(x) }; }
+
+		void store(double* dst) const noexcept { _mm_storeu_pd(dst, v); }
+
+		//==============================================================================
+		friend Batch operator- (Batch a) noexcept { return { _mm_xor_pd(a.v, _mm_set1_pd(-0.)) }; }
+
+		friend Batch operator+ (Batch a, Batch b) noexcept { return { _mm_add_pd(a.v, b.v) }; }
+
+		friend Batch operator- (Batch a, Batch b) noexcept { return { _mm_sub_pd(a.v, b.v) }; }
+
+		friend Batch operator* (Batch a, Batch b) noexcept { return { _mm_mul_pd(a.v, b.v) }; }
+
+		friend Batch operator/ (Batch a, Batch b) noexcept { return { _mm_div_pd(a.v, b.v) }; }
+
+		//==============================================================================
+		friend Batch min(Batch a, Batch b) noexcept { return { _mm_min_pd(a.v, b.v) }; }
+
+		friend Batch max(Batch a, Batch b) noexcept { return { _mm_max_pd(a.v, b.v) }; }
+
+		friend Batch sqrt(Batch a) noexcept { return { _mm_sqrt_pd(a.v) }; }
+
+		/** Lane-wise a > b ? ifTrue : ifFalse. */
+		friend Batch selectIfGreater(Batch a, Batch b, Batch ifTrue, Batch ifFalse) noexcept
+		{
+			const __m128d mask = _mm_cmpgt_pd(a.v, b.v);
+			return { _mm_or_pd(_mm_and_pd(mask, ifTrue.v), _mm_andnot_pd(mask, ifFalse.v)) };
+		}
+	};
+#endif
+}
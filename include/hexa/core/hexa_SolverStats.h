@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Define HEXA_SOLVER_STATS to make the iterative processors (SymDiodeClipper,
+// ActiveOnePoleFilter) record SolverStats. Without it the recording compiles to nothing
+// and the stats stay empty.
+#if defined(HEXA_SOLVER_STATS)
+	#define HEXA_SOLVER_STATS_ENABLED 1
+#else
+	#define HEXA_SOLVER_STATS_ENABLED 0
+#endif
+
+namespace hexa
+{
+	/**
+	 * Statistics of an iterative solver: histogram of the iterations per solve, how often
+	 * the iteration cap was hit, line search backtracks and the largest final residual |F|.
+	 */
+	struct SolverStats
+	{
+		static constexpr bool enabled = HEXA_SOLVER_STATS_ENABLED;
+
+		/** Iterations 0 ... numBins - 2, the last bin collects everything above. */
+		static constexpr size_t numBins = 34;
+
+		std::array<uint64_t, numBins> iterations{};
+		uint64_t numSolves{}, numCapHits{}, numBacktracks{};
+		double maxResidual{};
+
+		//==============================================================================
+		void record(size_t numIterations, bool hitCap, double residual) noexcept
+		{
+			if constexpr (enabled)
+			{
+				++iterations[std::min(numIterations, numBins - 1)];
+				++numSolves;
+				numCapHits += hitCap ? 1 : 0;
+				maxResidual = std::max(maxResidual, residual);
+			}
+		}
+
+		void addBacktracks(size_t count) noexcept
+		{
+			if constexpr (enabled) numBacktracks += count;
+		}
+
+		void merge(const SolverStats& other) noexcept
+		{
+			if constexpr (enabled)
+			{
+				for (size_t i = 0; i < numBins; ++i) iterations[i] += other.iterations[i];
+				numSolves += other.numSolves;
+				numCapHits += other.numCapHits;
+				numBacktracks += other.numBacktracks;
+				maxResidual = std::max(maxResidual, other.maxResidual);
+			}
+		}
+
+		void clear() noexcept
+		{
+			if constexpr (enabled) *this = SolverStats{};
+		}
+
+		//==============================================================================
+		double getMeanIterations() const noexcept
+		{
+			uint64_t sum = 0;
+			for (size_t i = 0; i < numBins; ++i) sum += i * iterations[i];
+			return numSolves ? double(sum) / double(numSolves) : 0.;
+		}
+
+		/** Highest iteration count seen (numBins - 1 means at least that many). */
+		size_t getMaxIterations() const noexcept
+		{
+			for (size_t i = numBins; i > 0; --i)
+			{
+				if (iterations[i - 1] != 0) return i - 1;
+			}
+			return 0;
+		}
+	};
+}
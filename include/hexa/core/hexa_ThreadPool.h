@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace hexa
+{
+	/**
+	 * Persistent work-stealing pool for block-synchronous work. parallelFor() splits the
+	 * task indices into one contiguous range per participant (the calling thread is one of
+	 * them). Every participant pops tasks off the front of its range and, once it is empty,
+	 * steals the back half of the next non-empty one. The call returns after all workers
+	 * have checked in, so it is a barrier per block. Threads are only created by the
+	 * constructor; between blocks they spin briefly and then sleep.
+	 */
+	class ThreadPool
+	{
+	public:
+		/** numThreads includes the thread calling parallelFor(), 1 means no workers. */
+		explicit ThreadPool(size_t numThreads = std::max(1u, std::thread::hardware_concurrency()))
+			: ranges(std::max<size_t>(numThreads, 1))
+		{
+			for (size_t i = 1; i < ranges.size(); ++i) workers.emplace_back([this, i] { workerLoop(i); });
+		}
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				quit = true;
+				generation.fetch_add(1, std::memory_order_release);
+			}
+			wakeUp.notify_all();
+
+			for (auto&& w : workers) w.join();
+		}
+
+		ThreadPool(const ThreadPool& other) = delete;
+		ThreadPool& operator= (const ThreadPool& other) = delete;
+
+		//==============================================================================
+		size_t getNumThreads() const noexcept { return ranges.size(); }
+
+		/** Calls fn(task) for every task in [0, numTasks), spread over all threads. Not reentrant. */
+		template <typename Fn>
+		void parallelFor(size_t numTasks, Fn&& fn)
+		{
+			if (numTasks == 0) return;
+
+			if (workers.empty() || numTasks == 1)
+			{
+				for (size_t t = 0; t < numTasks; ++t) fn(t);
+				return;
+			}
+
+			const size_t numParts = ranges.size();
+			for (size_t p = 0; p < numParts; ++p)
+			{
+				ranges[p].span.store(pack(numTasks * p / numParts, numTasks * (p + 1) / numParts), std::memory_order_relaxed);
+			}
+
+			context = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+			invoke = [](void* ctx, size_t task) { (*static_cast<std::remove_reference_t<Fn>*>(ctx))(task); };
+			pending.store(workers.size(), std::memory_order_relaxed);
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				generation.fetch_add(1, std::memory_order_release);
+			}
+			wakeUp.notify_all();
+
+			participate(0);
+
+			while (pending.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+		}
+
+	private:
+		// [begin, end) of task indices, packed so owner pops and steals are a single CAS.
+		struct alignas(64) Range
+		{
+			std::atomic<uint64_t> span{};
+		};
+
+		static uint64_t pack(uint64_t begin, uint64_t end) noexcept { return begin | (end << 32); }
+
+		static uint32_t beginOf(uint64_t span) noexcept { return uint32_t(span); }
+
+		static uint32_t endOf(uint64_t span) noexcept { return uint32_t(span >> 32); }
+
+		//==============================================================================
+		bool popFront(Range& r, size_t& task) noexcept
+		{
+			uint64_t span = r.span.load(std::memory_order_acquire);
+			while (beginOf(span) < endOf(span))
+			{
+				if (r.span.compare_exchange_weak(span, pack(beginOf(span) + 1, endOf(span)), std::memory_order_acq_rel))
+				{
+					task = beginOf(span);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/** Moves the back half of another range into the (empty) range of participant self. */
+		bool steal(size_t self) noexcept
+		{
+			const size_t numParts = ranges.size();
+			for (size_t k = 1; k < numParts; ++k)
+			{
+				Range& victim = ranges[(self + k) % numParts];
+				uint64_t span = victim.span.load(std::memory_order_acquire);
+				while (beginOf(span) < endOf(span))
+				{
+					const uint32_t count = endOf(span) - beginOf(span);
+					const uint32_t newEnd = endOf(span) - (count + 1) / 2;
+					if (victim.span.compare_exchange_weak(span, pack(beginOf(span), newEnd), std::memory_order_acq_rel))
+					{
+						ranges[self].span.store(pack(newEnd, endOf(span)), std::memory_order_release);
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		void participate(size_t self)
+		{
+			size_t task{};
+			do
+			{
+				while (popFront(ranges[self], task)) invoke(context, task);
+			} while (steal(self));
+		}
+
+		void workerLoop(size_t self)
+		{
+			uint64_t seen = 0;
+
+			for (;;)
+			{
+				// Blocks usually follow each other closely, spin a little before sleeping.
+				for (int spin = 0; spin < spinCount && generation.load(std::memory_order_acquire) == seen; ++spin)
+				{
+					std::this_thread::yield();
+				}
+
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					wakeUp.wait(lock, [&] { return generation.load(std::memory_order_acquire) != seen; });
+				}
+
+				seen = generation.load(std::memory_order_acquire);
+				if (quit) return;
+
+				participate(self);
+				pending.fetch_sub(1, std::memory_order_acq_rel);
+			}
+		}
+
+		//==============================================================================
+		static constexpr int spinCount = 1024;
+
+		std::vector<Range> ranges;
+		std::vector<std::thread> workers;
+
+		void* context{};
+		void (*invoke)(void*, size_t) {};
+
+		std::atomic<uint64_t> generation{ 0 };
+		std::atomic<size_t> pending{ 0 };
+		bool quit{ false };
+
+		std::mutex mutex;
+		std::condition_variable wakeUp;
+	};
+}
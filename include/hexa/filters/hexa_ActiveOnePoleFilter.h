@@ -1,14 +1,35 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <type_traits>
 
+#include "../core/hexa_Denormals.h"
+#include "../core/hexa_General.h"
+#include "../core/hexa_ParameterQueue.h"
+#include "../core/hexa_Silence.h"
+#include "../core/hexa_SolverStats.h"
+#include "../core/hexa_Simd.h"
 #include "../math/hexa_Constants.h"
+#include "../math/hexa_Pade.h"
 
 namespace hexa
 {
+	enum class ActiveOnePoleSolver { DampedNewton, FixedNewton };
+
+	enum class ActiveOnePoleParameter { frequency, drive };
+
 	/**
 	 * Active one pole filter with OTA (My challenge to Urs' one pole monster ;-) )
+	 *
+	 * ActiveOnePoleSolver::FixedNewton trades the damped Newton with line search for a fixed
+	 * number of branch-free Newton steps on pade::tanh, kept inside the [s - g, s + g] bracket
+	 * that holds the root. The cost per sample is constant and process() runs
+	 * simd::Batch<Type>::size channels in SIMD lanes. At the default 3 iterations the solver
+	 * error is below 1e-7 up to g = 2.5 (16 kHz at 44.1 kHz). The deviation from the damped Newton
+	 * comes from pade::tanh (< 1.4e-3 abs), about 5e-4 at 200 Hz and 9e-3 at 16 kHz cutoff.
 	 */
 	template <typename Type>
 	class ActiveOnePoleFilter
@@ -28,6 +49,24 @@ namespace hexa
 			gain = std::pow(Type(10), gainDb / 20);
 		}
 
+		/** Lock-free change from one control thread, applied at the start of the next process(). */
+		void postParameter(ActiveOnePoleParameter id, Type value) noexcept
+		{
+			events.push(static_cast<size_t>(id), value);
+		}
+
+		void setSolver(ActiveOnePoleSolver newSolver) noexcept
+		{
+			solver = newSolver;
+		}
+
+		/** Number of Newton steps of the FixedNewton solver. */
+		void setNumIterations(size_t newNumIterations) noexcept
+		{
+			assert(newNumIterations > 0);
+			numIterations = newNumIterations;
+		}
+
 		//==============================================================================
 		Type getCutoff() const noexcept { return cutoff; }
 
@@ -35,6 +74,53 @@ namespace hexa
 
 		Type getSampleRate() const noexcept { return sampleRate; }
 
+		ActiveOnePoleSolver getSolver() const noexcept { return solver; }
+
+		size_t getNumIterations() const noexcept { return numIterations; }
+
+		//==============================================================================
+		/**
+		 * Solver statistics of the last process() call and the processSample() calls since,
+		 * recorded only with HEXA_SOLVER_STATS defined. DampedNewton records its iterations,
+		 * cap hits, Armijo backtracks and |F| after the last step; FixedNewton its constant
+		 * iteration count and the residual of the pade::tanh equation it solves.
+		 */
+		const SolverStats& getBlockSolverStats() const noexcept { return blockStats; }
+
+		/** Solver statistics since prepare() or resetSolverStats(). */
+		SolverStats getSolverStats() const noexcept
+		{
+			SolverStats all = totalStats;
+			all.merge(blockStats);
+			return all;
+		}
+
+		void resetSolverStats() noexcept
+		{
+			blockStats.clear();
+			totalStats.clear();
+		}
+
+		//==============================================================================
+		/** See DenormalMode. */
+		void setDenormalMode(DenormalMode newMode) noexcept { denormals.setMode(newMode); }
+
+		DenormalMode getDenormalMode() const noexcept { return denormals.getMode(); }
+
+		//==============================================================================
+		/** Skips the silent channels of process(), see SilenceGate. */
+		void setSilenceBypass(bool shouldBypass) noexcept { silence.setEnabled(shouldBypass); }
+
+		void setSilenceThreshold(Type newThreshold) noexcept { silence.setThreshold(newThreshold); }
+
+		bool isSilenceBypassEnabled() const noexcept { return silence.isEnabled(); }
+
+		/**
+		 * Small-signal tail of the linearized filter (pole (1 - g) / (1 + g)). A saturated state
+		 * decays slower, so process() also waits for the state to settle below -120 dB.
+		 */
+		size_t getTailLength() const noexcept { return silence::tailFromPoleRadius(std::abs((1 - g) / (1 + g))); }
+
 		//==============================================================================
 		void prepare(Type sRate, size_t numChannels, [[maybe_unused]] size_t maxBlockSize) noexcept
 		{
@@ -42,15 +128,44 @@ namespace hexa
 
 			st.resize(numChannels);
 			update();
+			silence.prepare(numChannels);
 			reset();
+			resetSolverStats();
+		}
+
+		/** Posted parameters and denormal scope of a block, see Chain::beginBlock(). */
+		auto beginBlock() noexcept
+		{
+			applyParameters();
+			return denormals.protect(st);
 		}
 
 		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
 		{
-			assert(nChans <= st.size());;
+			assert(nChans <= st.size());
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			totalStats.merge(blockStats);
+			blockStats.clear();
+
+			const size_t tail = silence.isEnabled() ? getTailLength() : 0;
+
+			if (solver == ActiveOnePoleSolver::FixedNewton)
+			{
+				processFixed(inputs, outputs, nChans, nFrames, tail);
+				return;
+			}
 
 			for (size_t ch = 0; ch < nChans; ++ch)
 			{
+				if (silence.canSkip(ch, inputs[ch], nFrames, tail) && isSettled(ch, 1))
+				{
+					skip(outputs, ch, 1, nFrames);
+					continue;
+				}
+
 				auto&& ls = st[ch];
 
 				const Type* in = inputs[ch];
@@ -58,7 +173,7 @@ namespace hexa
 
 				for (size_t n = 0; n < nFrames; ++n)
 				{
-					out[n] = tick(in[n], ls);
+					out[n] = tick(in[n] + dc, ls);
 				}
 			}
 		}
@@ -66,22 +181,177 @@ namespace hexa
 		Type processSample(const Type& x, size_t ch)
 		{
 			assert(ch < st.size());
-			return tick(x, st[ch]);
+			return solver == ActiveOnePoleSolver::FixedNewton ? tickFixed(x * gain, st[ch], g) : tick(x, st[ch]);
 		}
 
-		// Same as processSample (introduced for brevity in complex processors)
+		// Same as processSample (introduced for brevity in complex processors), plus the input
+		// offset of an open denormal scope
 		Type operator() (const Type& x, size_t ch)
 		{
-			assert(ch < st.size());
-			return tick(x, st[ch]);
+			return processSample(x + denormals.getInputOffset(), ch);
 		}
 
 		void reset() noexcept
 		{
 			std::fill(st.begin(), st.end(), Type(0));
+			silence.reset();
 		}
 
 	private:
+		//==============================================================================
+		void applyParameters() noexcept
+		{
+			events.drain([this](size_t id, Type value)
+			{
+				switch (static_cast<ActiveOnePoleParameter>(id))
+				{
+				case ActiveOnePoleParameter::frequency: setFrequency(value); break;
+				case ActiveOnePoleParameter::drive: setDrive(value); break;
+				}
+			});
+		}
+
+		/** true if the states of the channels first ... first + num - 1 are below silence::tailDecay. */
+		bool isSettled(size_t first, size_t num) const noexcept
+		{
+			return std::all_of(st.begin() + first, st.begin() + first + num, [](Type s) { return std::abs(s) <= silence::tailDecay<Type>; });
+		}
+
+		void skip(Type** outputs, size_t first, size_t num, size_t nFrames) noexcept
+		{
+			for (size_t ch = first; ch < first + num; ++ch)
+			{
+				std::fill_n(outputs[ch], nFrames, Type(0));
+				st[ch] = 0;
+			}
+		}
+
+		void processFixed(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames, size_t tail) noexcept
+		{
+			using Batch = simd::Batch<Type>;
+			constexpr size_t laneWidth = Batch::size;
+			const size_t nVecChans = utils::roundDownToMultiple(nChans, laneWidth);
+
+			const auto vGain = Batch::broadcast(gain), vG = Batch::broadcast(g);
+			const Type dc = denormals.getInputOffset();
+
+			// Planar <-> lanes transpose scratch, small enough to live in L1.
+			alignas(64) Type frame[chunkSize * laneWidth];
+
+			for (size_t ch = 0; ch < nVecChans; ch += laneWidth)
+			{
+				if (silence.canSkipAll(ch, laneWidth, inputs, nFrames, tail) && isSettled(ch, laneWidth))
+				{
+					skip(outputs, ch, laneWidth, nFrames);
+					continue;
+				}
+
+				auto ls = Batch::load(&st[ch]);
+
+				for (size_t start = 0; start < nFrames; start += chunkSize)
+				{
+					const size_t len = std::min(chunkSize, nFrames - start);
+
+					for (size_t l = 0; l < laneWidth; ++l)
+					{
+						const Type* in = inputs[ch + l] + start;
+						for (size_t n = 0; n < len; ++n) frame[n * laneWidth + l] = in[n] + dc;
+					}
+
+					for (size_t n = 0; n < len; ++n)
+					{
+						const auto x = Batch::load(frame + n * laneWidth) * vGain;
+						tickFixed(x, ls, vG).store(frame + n * laneWidth);
+					}
+
+					for (size_t l = 0; l < laneWidth; ++l)
+					{
+						Type* out = outputs[ch + l] + start;
+						for (size_t n = 0; n < len; ++n) out[n] = frame[n * laneWidth + l];
+					}
+				}
+
+				ls.store(&st[ch]);
+			}
+
+			for (size_t ch = nVecChans; ch < nChans; ++ch)
+			{
+				if (silence.canSkip(ch, inputs[ch], nFrames, tail) && isSettled(ch, 1))
+				{
+					skip(outputs, ch, 1, nFrames);
+					continue;
+				}
+
+				auto&& ls = st[ch];
+
+				const Type* in = inputs[ch];
+				Type* out = outputs[ch];
+
+				for (size_t n = 0; n < nFrames; ++n)
+				{
+					out[n] = tickFixed((in[n] + dc) * gain, ls, g);
+				}
+			}
+		}
+
+		/** Fixed count Newton for s + g * tanh(x - y) - y = 0, V is Type or simd::Batch<Type>. */
+		template <typename V>
+		V tickFixed(V x, V& s, V gV) const noexcept
+		{
+			using std::min, std::max;
+
+			// The root is bracketed by s -+ g as |tanh| <= 1.
+			const V lo = s - gV, hi = s + gV;
+
+			// Initial guess from tanh(u) ~ u.
+			V y = min(max((s + gV * x) / (gV + V(1)), lo), hi);
+
+			for (size_t i = 0; i < numIterations; ++i)
+			{
+				// pade::tanh reaches 1 at 3.6467, clamping there keeps it monotonic and bounded.
+				const V u = min(max(x - y, V(-tanhClip)), V(tanhClip));
+
+				// y -= F / dF with tanh(u) = N / D expanded, so a step costs one division.
+				const V u2 = u * u;
+				const V N = (V(945) + (u2 + V(105)) * u2) * u;
+				const V D = V(945) + (V(15) * u2 + V(420)) * u2;
+				const V D2 = D * D;
+				y = y + D * ((s - y) * D + gV * N) / (gV * (D2 - N * N) + D2);
+				y = min(max(y, lo), hi);
+			}
+
+			if constexpr (SolverStats::enabled) recordFixed(x, y, s, gV);
+
+			// Update integrator
+			s = V(2) * y - s;
+
+			return y;
+		}
+
+		/** Lane-wise |s + g * pade::tanh(x - y) - y| of the equation tickFixed() solves. */
+		template <typename V>
+		void recordFixed(V x, V y, V s, V gV) const noexcept
+		{
+			using std::min, std::max;
+
+			const V u = min(max(x - y, V(-tanhClip)), V(tanhClip));
+			const V u2 = u * u;
+			const V N = (V(945) + (u2 + V(105)) * u2) * u;
+			const V D = V(945) + (V(15) * u2 + V(420)) * u2;
+			const V F = s + gV * N / D - y;
+
+			if constexpr (std::is_same_v<V, Type>)
+			{
+				blockStats.record(numIterations, false, std::abs(double(F)));
+			}
+			else
+			{
+				alignas(64) Type lanes[V::size];
+				F.store(lanes);
+				for (size_t l = 0; l < V::size; ++l) blockStats.record(numIterations, false, std::abs(double(lanes[l])));
+			}
+		}
+
 		//==============================================================================
 		Type tick(const Type& in, Type& s) noexcept
 		{
@@ -92,7 +362,7 @@ namespace hexa
 
 			// Damped Newton (see Kelley monography)
 			Type delta = Type(1.e9);
-			size_t iteration = 0;
+			size_t iteration = 0, numBacktracks = 0;
 			while (std::abs(delta) > TOL)
 			{
 				if (iteration++ > MAX_NUM_ITERATIONS) break;
@@ -118,10 +388,19 @@ namespace hexa
 
 					if (iarm++ > 8) break;
 				}
+				numBacktracks += iarm;
 
 				yV = yN;
 			}
 
+			if constexpr (SolverStats::enabled)
+			{
+				// The loop counter passes the cap by 2 when it breaks.
+				const bool hitCap = iteration > MAX_NUM_ITERATIONS + 1;
+				blockStats.record(hitCap ? iteration - 1 : iteration, hitCap, std::abs(double(s + g * std::tanh(x - yV) - yV)));
+				blockStats.addBacktracks(numBacktracks);
+			}
+
 			// Update integrator
 			s = 2 * yV - s;
 
@@ -140,6 +419,21 @@ namespace hexa
 
 		std::vector<Type> st{ 2 };
 
+		DenormalProtection<Type> denormals{};
+		SilenceGate<Type> silence{};
+
+		ActiveOnePoleSolver solver{ ActiveOnePoleSolver::DampedNewton };
+		size_t numIterations{ 3 };
+
+		ParameterQueue<Type, 2> events{};
+
+		// Written by the const tickFixed(), they are instrumentation and not state.
+		mutable SolverStats blockStats{};
+		SolverStats totalStats{};
+
+		static constexpr size_t chunkSize = 64;
+		static constexpr Type tanhClip = Type(3.6467);
+
 		// Newton parameters
 		static constexpr Type alpha = Type(1.e-4);
 		static constexpr Type sigma = Type(0.1);
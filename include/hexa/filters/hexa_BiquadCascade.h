@@ -0,0 +1,320 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <vector>
+
+#include "../core/hexa_Denormals.h"
+#include "../core/hexa_General.h"
+#include "../core/hexa_ParameterQueue.h"
+#include "../core/hexa_Silence.h"
+#include "../math/hexa_Constants.h"
+#include "hexa_RBJFilter.h"
+
+namespace hexa
+{
+	enum class BiquadCascadeParameter { cutoff, Q, gain, type, enabled };
+
+	/**
+	 * A serial chain of RBJ bi-quads (e.g. a parametric EQ bank). Coefficients of all sections
+	 * are kept in structure-of-arrays form and the states of one channel are contiguous,
+	 * so a block goes through every section in a single pass over the buffer.
+	 */
+	template <typename Type, size_t NumSections>
+	class BiquadCascade final
+	{
+		static_assert(NumSections > 0, "BiquadCascade needs at least one section");
+
+		using FilterType = RBJFilterType;
+	public:
+		BiquadCascade()
+		{
+			cutoff.fill(Type(1000));
+			R.fill(c<Type>::reciprSqrt2);
+			gainInDb.fill(Type(0));
+			type.fill(FilterType::peak);
+			enabled.fill(true);
+
+			for (size_t i = 0; i < NumSections; ++i) update(i);
+		}
+
+		//==============================================================================
+		static constexpr size_t getNumSections() noexcept { return NumSections; }
+
+		/** Sets all parameters of a section at once (with a single coefficient update). */
+		void setSection(size_t section, FilterType newType, Type freq, Type newQ, Type gainDb) noexcept
+		{
+			assert(section < NumSections);
+			type[section] = newType;
+			cutoff[section] = freq;
+			R[section] = 1 / (newQ + newQ);
+			gainInDb[section] = gainDb;
+			update(section);
+		}
+
+		void setCutoff(size_t section, Type freq) noexcept
+		{
+			assert(section < NumSections);
+			if (utils::areSame(freq, cutoff[section])) return;
+			cutoff[section] = freq;
+			update(section);
+		}
+
+		void setQ(size_t section, Type newQ) noexcept
+		{
+			assert(section < NumSections);
+			Type newR = 1 / (newQ + newQ);
+			if (utils::areSame(newR, R[section])) return;
+			R[section] = newR;
+			update(section);
+		}
+
+		void setGain(size_t section, Type gainDb) noexcept
+		{
+			assert(section < NumSections);
+			if (utils::areSame(gainDb, gainInDb[section])) return;
+			gainInDb[section] = gainDb;
+			update(section);
+		}
+
+		void setType(size_t section, FilterType newType) noexcept
+		{
+			assert(section < NumSections);
+			type[section] = newType;
+			update(section);
+		}
+
+		/** A disabled section becomes an identity (its states keep running at no extra cost). */
+		void setEnabled(size_t section, bool shouldBeEnabled) noexcept
+		{
+			assert(section < NumSections);
+			enabled[section] = shouldBeEnabled;
+			update(section);
+		}
+
+		/**
+		 * Lock-free change of a section from one control thread, applied at the start of the
+		 * next process() (the type goes as Type(RBJFilterType), enabled as 0 or 1).
+		 */
+		void postParameter(size_t section, BiquadCascadeParameter id, Type value) noexcept
+		{
+			assert(section < NumSections);
+			events.push(section * numSectionParameters + static_cast<size_t>(id), value);
+		}
+
+		//==============================================================================
+		Type getCutoff(size_t section) const noexcept { return cutoff[section]; }
+
+		Type getQ(size_t section) const noexcept { return 1 / (2 * R[section]); }
+
+		Type getGain(size_t section) const noexcept { return gainInDb[section]; }
+
+		FilterType getType(size_t section) const noexcept { return type[section]; }
+
+		bool isEnabled(size_t section) const noexcept { return enabled[section]; }
+
+		Type getSampleRate() const noexcept { return sampleRate; }
+
+		//==============================================================================
+		/** See DenormalMode. */
+		void setDenormalMode(DenormalMode newMode) noexcept { denormals.setMode(newMode); }
+
+		DenormalMode getDenormalMode() const noexcept { return denormals.getMode(); }
+
+		//==============================================================================
+		/** Skips the silent channels of process(), see SilenceGate. */
+		void setSilenceBypass(bool shouldBypass) noexcept { silence.setEnabled(shouldBypass); }
+
+		void setSilenceThreshold(Type newThreshold) noexcept { silence.setThreshold(newThreshold); }
+
+		bool isSilenceBypassEnabled() const noexcept { return silence.isEnabled(); }
+
+		/** Sum of the section tails (samples to decay by 120 dB, exact from the poles), saturates at silence::infiniteTail. */
+		size_t getTailLength() const noexcept
+		{
+			size_t tail = 0;
+			for (size_t i = 0; i < NumSections; ++i)
+			{
+				const size_t sectionTail = response::tailLength(BiquadCoefficients<Type>{ b0[i], b1[i], b2[i], a1[i], a2[i] });
+				if (sectionTail > silence::infiniteTail - tail) return silence::infiniteTail;
+				tail += sectionTail;
+			}
+			return tail;
+		}
+
+		//==============================================================================
+		void prepare(Type sRate, size_t numChannels, [[maybe_unused]] size_t maxBlockSize)
+		{
+			sampleRate = sRate;
+			st.resize(2 * NumSections * numChannels);
+
+			for (size_t i = 0; i < NumSections; ++i) update(i);
+			silence.prepare(numChannels);
+			reset();
+		}
+
+		/** Posted parameters and denormal scope of a block, see Chain::beginBlock(). */
+		auto beginBlock() noexcept
+		{
+			applyParameters();
+			return denormals.protect(st);
+		}
+
+		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
+		{
+			assert(2 * NumSections * nChans <= st.size());
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			const size_t tail = silence.isEnabled() ? getTailLength() : 0;
+
+			for (size_t ch = 0; ch < nChans; ++ch)
+			{
+				if (silence.canSkip(ch, inputs[ch], nFrames, tail))
+				{
+					std::fill_n(outputs[ch], nFrames, Type(0));
+					std::fill_n(&st[2 * NumSections * ch], 2 * NumSections, Type(0));
+					continue;
+				}
+
+				// Pull the channel states into locals, so they stay in registers for the block.
+				std::array<Type, NumSections> ls1, ls2;
+				Type* lst = &st[2 * NumSections * ch];
+				std::copy_n(lst, NumSections, ls1.begin());
+				std::copy_n(lst + NumSections, NumSections, ls2.begin());
+
+				const Type* in = inputs[ch];
+				Type* out = outputs[ch];
+
+				for (size_t n = 0; n < nFrames; ++n)
+				{
+					out[n] = tick(in[n] + dc, ls1.data(), ls2.data());
+				}
+
+				std::copy_n(ls1.begin(), NumSections, lst);
+				std::copy_n(ls2.begin(), NumSections, lst + NumSections);
+			}
+		}
+
+		/** Processes interleaved stereo frames (L R L R ...), no transpose to planar needed. */
+		void processInterleavedStereo(const Type* input, Type* output, size_t nFrames) noexcept
+		{
+			assert(st.size() >= 4 * NumSections);
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			std::array<Type, NumSections> l1, l2, r1, r2;
+			std::copy_n(st.begin(), NumSections, l1.begin());
+			std::copy_n(st.begin() + NumSections, NumSections, l2.begin());
+			std::copy_n(st.begin() + 2 * NumSections, NumSections, r1.begin());
+			std::copy_n(st.begin() + 3 * NumSections, NumSections, r2.begin());
+
+			for (size_t n = 0; n < 2 * nFrames; n += 2)
+			{
+				output[n] = tick(input[n] + dc, l1.data(), l2.data());
+				output[n + 1] = tick(input[n + 1] + dc, r1.data(), r2.data());
+			}
+
+			std::copy_n(l1.begin(), NumSections, st.begin());
+			std::copy_n(l2.begin(), NumSections, st.begin() + NumSections);
+			std::copy_n(r1.begin(), NumSections, st.begin() + 2 * NumSections);
+			std::copy_n(r2.begin(), NumSections, st.begin() + 3 * NumSections);
+		}
+
+		Type processSample(const Type& x, size_t ch) noexcept
+		{
+			assert(2 * NumSections * ch < st.size());
+			Type* lst = &st[2 * NumSections * ch];
+			return tick(x, lst, lst + NumSections);
+		}
+
+		// Same as processSample (introduced for brevity in complex processors), plus the input
+		// offset of an open denormal scope
+		Type operator() (const Type& x, size_t ch) noexcept
+		{
+			return processSample(x + denormals.getInputOffset(), ch);
+		}
+
+		void reset() noexcept
+		{
+			std::fill(st.begin(), st.end(), Type(0));
+			silence.reset();
+		}
+
+	private:
+		static constexpr size_t numSectionParameters = 5;
+
+		void applyParameters() noexcept
+		{
+			// Every touched section is redesigned once, whatever the number of its changes.
+			std::array<bool, NumSections> dirty{};
+			events.drain([&](size_t id, Type value)
+			{
+				const size_t i = id / numSectionParameters;
+				switch (static_cast<BiquadCascadeParameter>(id % numSectionParameters))
+				{
+				case BiquadCascadeParameter::cutoff: cutoff[i] = value; break;
+				case BiquadCascadeParameter::Q: R[i] = 1 / (value + value); break;
+				case BiquadCascadeParameter::gain: gainInDb[i] = value; break;
+				case BiquadCascadeParameter::type: type[i] = static_cast<FilterType>(static_cast<int>(value)); break;
+				case BiquadCascadeParameter::enabled: enabled[i] = value != Type(0); break;
+				}
+				dirty[i] = true;
+			});
+
+			for (size_t i = 0; i < NumSections; ++i)
+			{
+				if (dirty[i]) update(i);
+			}
+		}
+
+		Type tick(Type x, Type* s1, Type* s2) const noexcept
+		{
+			for (size_t i = 0; i < NumSections; ++i)
+			{
+				// Transposed canonical form (TDF-II), same as RBJFilter::tick.
+				const Type y = b0[i] * x + s1[i];
+
+				s1[i] = b1[i] * x - a1[i] * y + s2[i];
+				s2[i] = b2[i] * x - a2[i] * y;
+
+				x = y;
+			}
+
+			return x;
+		}
+
+		void update(size_t i) noexcept
+		{
+			const auto coeffs = enabled[i] ? designRBJ(type[i], cutoff[i], R[i], gainInDb[i], sampleRate)
+				: BiquadCoefficients<Type>{};
+
+			b0[i] = coeffs.b0;
+			b1[i] = coeffs.b1;
+			b2[i] = coeffs.b2;
+			a1[i] = coeffs.a1;
+			a2[i] = coeffs.a2;
+		}
+
+		//==============================================================================
+		Type sampleRate{ 44100. };
+
+		std::array<Type, NumSections> cutoff, R, gainInDb;
+		std::array<FilterType, NumSections> type;
+		std::array<bool, NumSections> enabled;
+
+		// Coefficients (SoA)
+		std::array<Type, NumSections> b0{}, b1{}, b2{}, a1{}, a2{};
+
+		// Per channel: [s1 x NumSections][s2 x NumSections]
+		std::vector<Type> st = std::vector<Type>(4 * NumSections);
+
+		DenormalProtection<Type> denormals{};
+		SilenceGate<Type> silence{};
+
+		ParameterQueue<Type, numSectionParameters * NumSections> events{};
+	};
+}
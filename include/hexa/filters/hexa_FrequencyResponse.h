@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "../core/hexa_Silence.h"
+#include "../core/hexa_Simd.h"
+#include "../math/hexa_Constants.h"
+
+namespace hexa
+{
+	/** Bi-quad coefficients, normalized by a0. */
+	template <typename Type>
+	struct BiquadCoefficients
+	{
+		Type b0{ 1 }, b1{}, b2{}, a1{}, a2{};
+	};
+
+	namespace response
+	{
+		/**
+		 * Transfer function of the two-state trapezoidal systems used by the filters here:
+		 * u = M * (p * x + s), s' = 2 * u - s, y = c * u + d * x.
+		 */
+		template <typename Type>
+		BiquadCoefficients<Type> fromStateSpace(Type m11, Type m12, Type m21, Type m22, Type p1, Type p2, Type c1, Type c2, Type d) noexcept
+		{
+			// s' = F * s + G * x, y = H * s + D * x
+			const Type f11 = 2 * m11 - 1, f12 = 2 * m12, f21 = 2 * m21, f22 = 2 * m22 - 1;
+			const Type mp1 = m11 * p1 + m12 * p2, mp2 = m21 * p1 + m22 * p2;
+			const Type g1 = 2 * mp1, g2 = 2 * mp2;
+			const Type h1 = c1 * m11 + c2 * m21, h2 = c1 * m12 + c2 * m22;
+			const Type D = c1 * mp1 + c2 * mp2 + d;
+
+			// H(z) = D + H * adj(zI - F) * G / det(zI - F)
+			const Type tr = f11 + f22, det = f11 * f22 - f12 * f21;
+			const Type hg = h1 * g1 + h2 * g2;
+			const Type k = h1 * (f12 * g2 - f22 * g1) + h2 * (f21 * g1 - f11 * g2);
+
+			return { D, hg - D * tr, D * det + k, -tr, det };
+		}
+
+		/** Transfer function of the TPT one pole, y = c * lp + d * x with lp = G * (x - s) + s. */
+		template <typename Type>
+		BiquadCoefficients<Type> fromOnePole(Type G, Type c, Type d) noexcept
+		{
+			const Type pole = 2 * G - 1;
+			return { c * G + d, c * G + d * pole, 0, pole, 0 };
+		}
+
+		//==============================================================================
+		namespace detail
+		{
+			/** sin(x) for |x| <= pi / 2 */
+			template <typename Type, typename V>
+			V sinHalfPi(V x) noexcept
+			{
+				constexpr int terms = sizeof(Type) > 4 ? 11 : 7;
+				const V x2 = x * x;
+				V p{ Type(1) };
+				for (int n = terms - 1; n > 0; --n) p = V{ Type(1) } - x2 * p * V{ Type(1) / Type((2 * n) * (2 * n + 1)) };
+				return x * p;
+			}
+
+			/** cos(x) for |x| <= pi / 2 */
+			template <typename Type, typename V>
+			V cosHalfPi(V x) noexcept
+			{
+				constexpr int terms = sizeof(Type) > 4 ? 11 : 7;
+				const V x2 = x * x;
+				V p{ Type(1) };
+				for (int n = terms - 1; n > 0; --n) p = V{ Type(1) } - x2 * p * V{ Type(1) / Type((2 * n - 1) * (2 * n)) };
+				return p;
+			}
+
+			template <typename Type, typename V>
+			V atan2(V y, V x) noexcept
+			{
+				constexpr int terms = sizeof(Type) > 4 ? 16 : 8;
+				const V zero{ Type(0) }, one{ Type(1) };
+				const V ax = max(x, -x), ay = max(y, -y);
+				const V t = min(ax, ay) / max(max(ax, ay), V{ Type(1e-30) });
+
+				// atan(t) = pi / 4 + atan((t - 1) / (t + 1)) keeps the series argument below tan(pi / 8)
+				const V reduce{ Type(0.41421356237309503) };
+				const V r = selectIfGreater(t, reduce, (t - one) / (t + one), t);
+				const V r2 = r * r;
+
+				V p{ Type(1) / Type(2 * terms - 1) * ((terms - 1) % 2 ? -1 : 1) };
+				for (int k = terms - 2; k >= 0; --k) p = p * r2 + V{ Type(1) / Type(2 * k + 1) * (k % 2 ? -1 : 1) };
+
+				V a = selectIfGreater(t, reduce, V{ c<Type>::quarterPi }, zero) + r * p;
+				a = selectIfGreater(ay, ax, V{ c<Type>::halfPi } - a, a);
+				a = selectIfGreater(zero, x, V{ c<Type>::pi } - a, a);
+				return selectIfGreater(zero, y, -a, a);
+			}
+
+			/** Runs kernel(Batch) over n inputs, the last partial batch goes through a padded copy. */
+			template <typename Type, typename Kernel>
+			void forEachBatch(const Type* input, Type* output, size_t n, Kernel&& kernel) noexcept
+			{
+				using Batch = simd::Batch<Type>;
+
+				size_t i = 0;
+				for (; i + Batch::size <= n; i += Batch::size) kernel(Batch::load(input + i)).store(output + i);
+
+				if (i < n)
+				{
+					Type in[Batch::size]{}, out[Batch::size]{};
+					std::copy(input + i, input + n, in);
+					kernel(Batch::load(in)).store(out);
+					std::copy_n(out, n - i, output + i);
+				}
+			}
+		}
+
+		//==============================================================================
+		/**
+		 * |H(e^jw)| at n frequencies in Hz (clamped to [0, sampleRate / 2]), vectorized over
+		 * the bins. With phi = sin^2(w / 2), |b0 + b1 z^-1 + b2 z^-2|^2 is
+		 * ((b0 + b1 + b2) (1 - phi) - (b0 - b1 + b2) phi)^2 + 4 phi (1 - phi) (b0 - b2)^2,
+		 * a sum of squares that keeps notches and low cutoffs accurate in float.
+		 */
+		template <typename Type>
+		void magnitude(const BiquadCoefficients<Type>& h, Type sampleRate, const Type* freqs, Type* mags, size_t n) noexcept
+		{
+			using Batch = simd::Batch<Type>;
+
+			const Batch nyquist{ sampleRate / 2 }, scale{ c<Type>::pi / sampleRate }, zero{ Type(0) }, one{ Type(1) }, four{ Type(4) };
+			const Batch bP{ h.b0 + h.b1 + h.b2 }, bM{ h.b0 - h.b1 + h.b2 }, bD{ (h.b0 - h.b2) * (h.b0 - h.b2) };
+			const Batch aP{ 1 + h.a1 + h.a2 }, aM{ 1 - h.a1 + h.a2 }, aD{ (1 - h.a2) * (1 - h.a2) };
+			const Batch tiny{ Type(1e-30) };
+
+			detail::forEachBatch(freqs, mags, n, [&](Batch f)
+			{
+				const Batch sh = detail::sinHalfPi<Type>(min(max(f, zero), nyquist) * scale);
+				const Batch phi = sh * sh, phi1 = one - phi, cross = four * phi * phi1;
+
+				const Batch reB = bP * phi1 - bM * phi, reA = aP * phi1 - aM * phi;
+				const Batch num = reB * reB + cross * bD;
+				const Batch den = reA * reA + cross * aD;
+
+				return sqrt(num / max(den, tiny));
+			});
+		}
+
+		/** arg H(e^jw) in radians, in (-pi, pi], at n frequencies in Hz. */
+		template <typename Type>
+		void phase(const BiquadCoefficients<Type>& h, Type sampleRate, const Type* freqs, Type* phases, size_t n) noexcept
+		{
+			using Batch = simd::Batch<Type>;
+
+			const Batch nyquist{ sampleRate / 2 }, scale{ c<Type>::pi / sampleRate }, zero{ Type(0) }, one{ Type(1) }, two{ Type(2) };
+			const Batch b0{ h.b0 }, b1{ h.b1 }, b2{ h.b2 }, a1{ h.a1 }, a2{ h.a2 };
+
+			detail::forEachBatch(freqs, phases, n, [&](Batch f)
+			{
+				const Batch halfW = min(max(f, zero), nyquist) * scale;
+				const Batch sh = detail::sinHalfPi<Type>(halfW), ch = detail::cosHalfPi<Type>(halfW);
+
+				// e^-jw = c - js, e^-2jw = c2 - js2
+				const Batch cw = one - two * sh * sh, sw = two * sh * ch;
+				const Batch c2 = two * cw * cw - one, s2 = two * sw * cw;
+
+				const Batch reB = b0 + b1 * cw + b2 * c2, imB = -(b1 * sw + b2 * s2);
+				const Batch reA = one + a1 * cw + a2 * c2, imA = -(a1 * sw + a2 * s2);
+
+				// arg(B / A) = arg(B * conj(A))
+				return detail::atan2<Type>(imB * reA - reB * imA, reB * reA + imB * imA);
+			});
+		}
+
+		//==============================================================================
+		/**
+		 * Samples for the impulse response to decay by silence::tailDecay (-120 dB), from the
+		 * largest pole radius plus the two samples of the zeros. silence::infiniteTail if unstable.
+		 */
+		template <typename Type>
+		size_t tailLength(const BiquadCoefficients<Type>& h) noexcept
+		{
+			// Poles are the roots of z^2 + a1 z + a2.
+			const Type disc = h.a1 * h.a1 - 4 * h.a2;
+			const Type radius = disc < 0 ? std::sqrt(h.a2) : (std::abs(h.a1) + std::sqrt(disc)) / 2;
+
+			const size_t tail = silence::tailFromPoleRadius(radius);
+			return tail == silence::infiniteTail ? tail : tail + 2;
+		}
+	}
+}
@@ -4,13 +4,19 @@
 #include <cassert>
 #include <vector>
 
+#include "../core/hexa_Denormals.h"
 #include "../core/hexa_General.h"
+#include "../core/hexa_ParameterQueue.h"
+#include "../core/hexa_Silence.h"
+#include "hexa_FrequencyResponse.h"
 #include "hexa_Prewarpers.h"
 
 namespace hexa
 {
 	enum class OnePoleType { LP, HP, AP, LS, HS, tilt };
 
+	enum class OnePoleParameter { cutoff, gain, type };
+
 	template <typename Type, typename Prewarper = TaylorPrewarper<Type>>
 	class OnePoleFilter final
 	{
@@ -40,12 +46,57 @@ namespace hexa
 			update();
 		}
 
+		/**
+		 * Lock-free change from one control thread, applied at the start of the next process()
+		 * (the type goes as Type(OnePoleType)).
+		 */
+		void postParameter(OnePoleParameter id, Type value) noexcept
+		{
+			events.push(static_cast<size_t>(id), value);
+		}
+
 		//==============================================================================		
 		Type getCutoff() const noexcept { return cutoff; }
 
 		Type getGain() const noexcept { return gain; }
 
-		Type getType() const noexcept { return type; }
+		FilterType getType() const noexcept { return type; }
+
+		//==============================================================================
+		/** The current coefficients as a z-domain bi-quad (changes still queued by postParameter() not included). */
+		BiquadCoefficients<Type> getTransferFunction() const noexcept
+		{
+			return response::fromOnePole(G, a1, a0);
+		}
+
+		/** |H| at n frequencies in Hz, vectorized over the bins. */
+		void getMagnitudeResponse(const Type* freqs, Type* mags, size_t n) const noexcept
+		{
+			response::magnitude(getTransferFunction(), sampleRate, freqs, mags, n);
+		}
+
+		/** arg H in radians at n frequencies in Hz, vectorized over the bins. */
+		void getPhaseResponse(const Type* freqs, Type* phases, size_t n) const noexcept
+		{
+			response::phase(getTransferFunction(), sampleRate, freqs, phases, n);
+		}
+
+		//==============================================================================
+		/** See DenormalMode. */
+		void setDenormalMode(DenormalMode newMode) noexcept { denormals.setMode(newMode); }
+
+		DenormalMode getDenormalMode() const noexcept { return denormals.getMode(); }
+
+		//==============================================================================
+		/** Skips the silent channels of process(), see SilenceGate. */
+		void setSilenceBypass(bool shouldBypass) noexcept { silence.setEnabled(shouldBypass); }
+
+		void setSilenceThreshold(Type newThreshold) noexcept { silence.setThreshold(newThreshold); }
+
+		bool isSilenceBypassEnabled() const noexcept { return silence.isEnabled(); }
+
+		/** Samples for the impulse response to decay by 120 dB, exact from the poles. */
+		size_t getTailLength() const noexcept { return response::tailLength(getTransferFunction()); }
 
 		//==============================================================================		
 		void prepare(Type sRate, size_t numChannels, [[maybe_unused]] size_t maxBlockSize) noexcept
@@ -55,15 +106,35 @@ namespace hexa
 			s.resize(numChannels, Type());
 
 			update();
+			silence.prepare(numChannels);
 			reset();
 		}
 
+		/** Posted parameters and denormal scope of a block, see Chain::beginBlock(). */
+		auto beginBlock() noexcept
+		{
+			applyParameters();
+			return denormals.protect(s);
+		}
+
 		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
 		{
 			assert(nChans <= s.size());
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
 	
+			const size_t tail = silence.isEnabled() ? getTailLength() : 0;
+
 			for (size_t ch = 0; ch < nChans; ++ch)
 			{
+				if (silence.canSkip(ch, inputs[ch], nFrames, tail))
+				{
+					std::fill_n(outputs[ch], nFrames, Type(0));
+					s[ch] = 0;
+					continue;
+				}
+
 				auto&& ls = s[ch];
 
 				const Type* in = inputs[ch];
@@ -71,30 +142,66 @@ namespace hexa
 
 				for (size_t n = 0; n < nFrames; ++n)
 				{
-					out[n] = tick(in[n], ls);
+					out[n] = tick(in[n] + dc, ls);
 				}
 			}
 		}
 
+		/** Processes interleaved stereo frames (L R L R ...), no transpose to planar needed. */
+		void processInterleavedStereo(const Type* input, Type* output, size_t nFrames) noexcept
+		{
+			assert(s.size() >= 2);
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			Type l = s[0], r = s[1];
+
+			for (size_t n = 0; n < 2 * nFrames; n += 2)
+			{
+				output[n] = tick(input[n] + dc, l);
+				output[n + 1] = tick(input[n + 1] + dc, r);
+			}
+
+			s[0] = l; s[1] = r;
+		}
+
 		Type processSample(const Type& x, size_t ch)
 		{
 			assert(ch < s.size());
 			return tick(x, s[ch]);
 		}
 
-		// Same as processSample (introduced for brevity in complex processors)
+		// Same as processSample (introduced for brevity in complex processors), plus the input
+		// offset of an open denormal scope
 		Type operator() (const Type& x, size_t ch)
 		{
 			assert(ch < s.size());
-			return tick(x, s[ch]);
+			return tick(x + denormals.getInputOffset(), s[ch]);
 		}
 
 		void reset() noexcept
 		{
 			std::fill(s.begin(), s.end(), Type(0));
+			silence.reset();
 		}
 
 	private:
+		void applyParameters() noexcept
+		{
+			const bool changed = events.drain([this](size_t id, Type value)
+			{
+				switch (static_cast<OnePoleParameter>(id))
+				{
+				case OnePoleParameter::cutoff: cutoff = std::clamp(value, Type(5.), Type(20.e3)); break;
+				case OnePoleParameter::gain: gain = std::clamp(value, Type(-48.), Type(48.)); break;
+				case OnePoleParameter::type: type = static_cast<FilterType>(static_cast<int>(value)); break;
+				}
+			});
+
+			if (changed) update();
+		}
+
 		Type tick(const Type& x, Type& ls)
 		{
 			auto v = G * (x - ls);
@@ -171,6 +278,11 @@ namespace hexa
 		Type g{}, G{}, a1{}, a0{};
 		std::vector<Type> s{};
 
+		DenormalProtection<Type> denormals{};
+		SilenceGate<Type> silence{};
+
 		Prewarper pw{};
+
+		ParameterQueue<Type, 3> events{};
 	};
 }
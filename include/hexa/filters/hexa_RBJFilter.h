@@ -5,15 +5,137 @@
 #include <cmath>
 #include <vector>
 
+#include "../core/hexa_Denormals.h"
 #include "../core/hexa_General.h"
+#include "../core/hexa_ParameterQueue.h"
+#include "../core/hexa_Silence.h"
+#include "../core/hexa_Simd.h"
+#include "../math/hexa_Constants.h"
+#include "../math/hexa_Series.h"
+#include "hexa_FrequencyResponse.h"
 
 namespace hexa
 {
 	enum class RBJFilterType { LP, HP, BP, BP1, LS, HS, peak, notch, AP };
 
+	enum class RBJFilterParameter { cutoff, Q, gain, type };
+
+	/**
+	 * RBJ Cookbook design from the precalculated trigonometric and gain terms
+	 * (alpha = sin(w0) / (2 * Q), A = 10^(dB / 40), ASqRt = sqrt(A)).
+	 */
+	template <typename Type>
+	constexpr BiquadCoefficients<Type> designRBJ(RBJFilterType type, Type cosw0, Type sinw0, Type alpha, Type A, Type ASqRt) noexcept
+	{
+		Type b0{ 1 }, b1{}, b2{}, a0{ 1 }, a1{}, a2{};
+		switch (type)
+		{
+		case RBJFilterType::LP:
+			b0 = (1 - cosw0) / 2;
+			b1 = 1 - cosw0;
+			b2 = (1 - cosw0) / 2;
+			a0 = 1 + alpha;
+			a1 = -2 * cosw0;
+			a2 = 1 - alpha;
+			break;
+		case RBJFilterType::BP:
+			b0 = sinw0 / 2;
+			b1 = 0;
+			b2 = -sinw0 / 2.;
+			a0 = 1 + alpha;
+			a1 = -2 * cosw0;
+			a2 = 1 - alpha;
+			break;
+		case RBJFilterType::HP:
+			b0 = (1 + cosw0) / 2;
+			b1 = -(1 + cosw0);
+			b2 = (1 + cosw0) / 2;
+			a0 = 1 + alpha;
+			a1 = -2 * cosw0;
+			a2 = 1 - alpha;
+			break;
+		case RBJFilterType::BP1:
+			b0 = alpha;
+			b1 = 0;
+			b2 = -alpha;
+			a0 = 1 + alpha;
+			a1 = -2 * cosw0;
+			a2 = 1 - alpha;
+			break;
+		case RBJFilterType::LS:
+			b0 = A * ((A + 1) - (A - 1) * cosw0 + 2 * ASqRt * alpha);
+			b1 = 2 * A * ((A - 1) - (A + 1) * cosw0);
+			b2 = A * ((A + 1) - (A - 1) * cosw0 - 2 * ASqRt * alpha);
+			a0 = (A + 1) + (A - 1) * cosw0 + 2 * ASqRt * alpha;
+			a1 = -2 * ((A - 1) + (A + 1) * cosw0);
+			a2 = (A + 1) + (A - 1) * cosw0 - 2 * ASqRt * alpha;
+			break;
+		case RBJFilterType::HS:
+			b0 = A * ((A + 1) + (A - 1) * cosw0 + 2 * ASqRt * alpha);
+			b1 = -2 * A * ((A - 1) + (A + 1) * cosw0);
+			b2 = A * ((A + 1) + (A - 1) * cosw0 - 2 * ASqRt * alpha);
+			a0 = (A + 1) - (A - 1) * cosw0 + 2 * ASqRt * alpha;
+			a1 = 2 * ((A - 1) - (A + 1) * cosw0);
+			a2 = (A + 1) - (A - 1) * cosw0 - 2 * ASqRt * alpha;
+			break;
+		case RBJFilterType::peak:
+			b0 = 1 + 1 * alpha * A;
+			b1 = -2 * cosw0;
+			b2 = 1 - 1 * alpha * A;
+			a0 = 1 + alpha / A;
+			a1 = -2 * cosw0;
+			a2 = 1 - alpha / A;
+			break;
+		case RBJFilterType::notch:
+			b0 = 1;
+			b1 = -2 * cosw0;
+			b2 = 1;
+			a0 = 1 + alpha;
+			a1 = -2 * cosw0;
+			a2 = 1 - alpha;
+			break;
+		case RBJFilterType::AP:
+			b0 = 1 - alpha;
+			b1 = -2 * cosw0;
+			b2 = 1 + alpha;
+			a0 = 1 + alpha;
+			a1 = -2 * cosw0;
+			a2 = 1 - alpha;
+			break;
+		}
+
+		return { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+	}
+
+	/** RBJ Cookbook design from the user-facing parameters (R = 1 / (2 * Q)). */
+	template <typename Type>
+	BiquadCoefficients<Type> designRBJ(RBJFilterType type, Type cutoff, Type R, Type gainInDb, Type sampleRate) noexcept
+	{
+		const Type ASqRt = std::pow(Type(10), gainInDb / 80);
+		const Type w0 = c<Type>::twoPi * cutoff / sampleRate;
+		const Type sinw0 = std::sin(w0);
+
+		return designRBJ(type, std::cos(w0), sinw0, sinw0 * R, ASqRt * ASqRt, ASqRt);
+	}
+
+	/** Same as designRBJ from the user-facing parameters, usable in constant expressions. */
+	template <typename Type>
+	constexpr BiquadCoefficients<Type> designRBJConstexpr(RBJFilterType type, Type cutoff, Type R, Type gainInDb, Type sampleRate) noexcept
+	{
+		const Type ASqRt = series::pow10(gainInDb / 80);
+		const Type w0 = c<Type>::twoPi * cutoff / sampleRate;
+		const Type sinw0 = series::sin(w0);
+
+		return designRBJ(type, series::cos(w0), sinw0, sinw0 * R, ASqRt * ASqRt, ASqRt);
+	}
+
 	/**
 	 * Implementation of a classical bi-quad filter, based on the famous RBJ Cookbook paper
 	 * by Robert Bristow-Johnson
+	 *
+	 * States are stored interleaved in groups of simd::Batch<Type>::size channels
+	 * ([s1 x lanes][s2 x lanes] per group), so processVectorized can keep a whole group
+	 * in two registers.
 	 */
 	template <typename Type>
 	class RBJFilter
@@ -41,7 +163,7 @@ namespace hexa
 			update<false, false>();
 		}
 
-		void setGain(double gainDb)
+		void setGain(Type gainDb)
 		{
 			if (utils::areSame(gainInDb, gainDb)) return;
 			gainInDb = gainDb;
@@ -55,60 +177,266 @@ namespace hexa
 			update<true, true>();
 		}
 
+		/**
+		 * Lock-free change from one control thread, applied at the start of the next process()
+		 * (the type goes as Type(RBJFilterType)).
+		 */
+		void postParameter(RBJFilterParameter id, Type value) noexcept
+		{
+			events.push(static_cast<size_t>(id), value);
+		}
+
+		//==============================================================================
+		/** The current coefficients as a z-domain bi-quad (changes still queued by postParameter() not included). */
+		BiquadCoefficients<Type> getTransferFunction() const noexcept
+		{
+			return { b0Da0, b1Da0, b2Da0, a1Da0, a2Da0 };
+		}
+
+		/** |H| at n frequencies in Hz, vectorized over the bins. */
+		void getMagnitudeResponse(const Type* freqs, Type* mags, size_t n) const noexcept
+		{
+			response::magnitude(getTransferFunction(), sampleRate, freqs, mags, n);
+		}
+
+		/** arg H in radians at n frequencies in Hz, vectorized over the bins. */
+		void getPhaseResponse(const Type* freqs, Type* phases, size_t n) const noexcept
+		{
+			response::phase(getTransferFunction(), sampleRate, freqs, phases, n);
+		}
+
+		//==============================================================================
+		/** See DenormalMode. */
+		void setDenormalMode(DenormalMode newMode) noexcept { denormals.setMode(newMode); }
+
+		DenormalMode getDenormalMode() const noexcept { return denormals.getMode(); }
+
+		//==============================================================================
+		/** Skips the silent channels of process(), see SilenceGate. */
+		void setSilenceBypass(bool shouldBypass) noexcept { silence.setEnabled(shouldBypass); }
+
+		void setSilenceThreshold(Type newThreshold) noexcept { silence.setThreshold(newThreshold); }
+
+		bool isSilenceBypassEnabled() const noexcept { return silence.isEnabled(); }
+
+		/** Samples for the impulse response to decay by 120 dB, exact from the poles. */
+		size_t getTailLength() const noexcept { return response::tailLength(getTransferFunction()); }
+
 		//==============================================================================
 		void prepare(Type sRate, size_t numChannels, [[maybe_unused]] size_t maxBlockSize) noexcept
 		{
 			sampleRate = sRate;
 
-			st1.resize(numChannels);
-			st2.resize(numChannels);
+			numChans = numChannels;
+			st.resize(2 * utils::alignUp(numChannels, laneWidth));
 
 			update<true, true>();
+			silence.prepare(numChannels);
 			reset();
 		}
 
+		/** Posted parameters and denormal scope of a block, see Chain::beginBlock(). */
+		auto beginBlock() noexcept
+		{
+			applyParameters();
+			return denormals.protect(st);
+		}
+
 		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
 		{
-			assert(nChans <= st1.size());
-			assert(nChans <= st2.size());
+			assert(nChans <= numChans);
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			const size_t tail = silence.isEnabled() ? getTailLength() : 0;
 
 			for (size_t ch = 0; ch < nChans; ++ch)
 			{
-				auto&& ls1 = st1[ch];
-				auto&& ls2 = st2[ch];
+				if (silence.canSkip(ch, inputs[ch], nFrames, tail))
+				{
+					skip(outputs[ch], ch, nFrames);
+					continue;
+				}
+
+				auto&& ls1 = s1(ch);
+				auto&& ls2 = s2(ch);
+
+				const Type* in = inputs[ch];
+				Type* out = outputs[ch];
+
+				for (size_t n = 0; n < nFrames; ++n)
+				{
+					out[n] = tick(in[n] + dc, ls1, ls2);
+				}
+			}
+		}
+
+		/**
+		 * Same as process, but runs simd::Batch<Type>::size channels at once in SIMD lanes.
+		 * Gives the same output as the scalar tick; leftover channels are processed by it.
+		 */
+		void processVectorized(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
+		{
+			assert(nChans <= numChans);
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			using Batch = simd::Batch<Type>;
+			const size_t nVecChans = utils::roundDownToMultiple(nChans, laneWidth);
+			const size_t tail = silence.isEnabled() ? getTailLength() : 0;
+
+			const auto b0 = Batch::broadcast(b0Da0), b1 = Batch::broadcast(b1Da0), b2 = Batch::broadcast(b2Da0);
+			const auto a1 = Batch::broadcast(a1Da0), a2 = Batch::broadcast(a2Da0);
+
+			// Planar <-> lanes transpose scratch, small enough to live in L1.
+			alignas(64) Type frame[chunkSize * laneWidth];
+
+			for (size_t ch = 0; ch < nVecChans; ch += laneWidth)
+			{
+				if (silence.canSkipAll(ch, laneWidth, inputs, nFrames, tail))
+				{
+					for (size_t l = 0; l < laneWidth; ++l) skip(outputs[ch + l], ch + l, nFrames);
+					continue;
+				}
+
+				Type* lst = &s1(ch);
+				auto ls1 = Batch::load(lst);
+				auto ls2 = Batch::load(lst + laneWidth);
+
+				for (size_t start = 0; start < nFrames; start += chunkSize)
+				{
+					const size_t len = std::min(chunkSize, nFrames - start);
+
+					for (size_t l = 0; l < laneWidth; ++l)
+					{
+						const Type* in = inputs[ch + l] + start;
+						for (size_t n = 0; n < len; ++n) frame[n * laneWidth + l] = in[n] + dc;
+					}
+
+					for (size_t n = 0; n < len; ++n)
+					{
+						// Transposed canonical form (TDF-II), same operation order as tick.
+						const auto x = Batch::load(frame + n * laneWidth);
+						const auto y = b0 * x + ls1;
+
+						ls1 = b1 * x - a1 * y + ls2;
+						ls2 = b2 * x - a2 * y;
+
+						y.store(frame + n * laneWidth);
+					}
+
+					for (size_t l = 0; l < laneWidth; ++l)
+					{
+						Type* out = outputs[ch + l] + start;
+						for (size_t n = 0; n < len; ++n) out[n] = frame[n * laneWidth + l];
+					}
+				}
+
+				ls1.store(lst);
+				ls2.store(lst + laneWidth);
+			}
+
+			for (size_t ch = nVecChans; ch < nChans; ++ch)
+			{
+				if (silence.canSkip(ch, inputs[ch], nFrames, tail))
+				{
+					skip(outputs[ch], ch, nFrames);
+					continue;
+				}
+
+				auto&& ls1 = s1(ch);
+				auto&& ls2 = s2(ch);
 
 				const Type* in = inputs[ch];
 				Type* out = outputs[ch];
 
 				for (size_t n = 0; n < nFrames; ++n)
 				{
-					out[n] = tick(in[n], ls1, ls2);
+					out[n] = tick(in[n] + dc, ls1, ls2);
 				}
 			}
 		}
 
+		/** Processes interleaved stereo frames (L R L R ...), no transpose to planar needed. */
+		void processInterleavedStereo(const Type* input, Type* output, size_t nFrames) noexcept
+		{
+			assert(numChans >= 2);
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			Type l1 = s1(0), l2 = s2(0), r1 = s1(1), r2 = s2(1);
+
+			for (size_t n = 0; n < 2 * nFrames; n += 2)
+			{
+				output[n] = tick(input[n] + dc, l1, l2);
+				output[n + 1] = tick(input[n + 1] + dc, r1, r2);
+			}
+
+			s1(0) = l1; s2(0) = l2; s1(1) = r1; s2(1) = r2;
+		}
+
 		Type processSample(const Type& x, size_t ch)
 		{
-			assert(ch < st1.size());
-			assert(ch < st2.size());
-			return tick(x, st1[ch], st2[ch]);
+			assert(ch < numChans);
+			return tick(x, s1(ch), s2(ch));
 		}
 
-		// Same as processSample (introduced for brevity in complex processors)
+		// Same as processSample (introduced for brevity in complex processors), plus the input
+		// offset of an open denormal scope
 		Type operator() (const Type& x, size_t ch)
 		{
-			assert(ch < st1.size());
-			assert(ch < st2.size());
-			return tick(x, st1[ch], st2[ch]);
+			assert(ch < numChans);
+			return tick(x + denormals.getInputOffset(), s1(ch), s2(ch));
 		}
 
 		void reset() noexcept
 		{
-			std::fill(st1.begin(), st1.end(), Type(0));
-			std::fill(st2.begin(), st2.end(), Type(0));
+			std::fill(st.begin(), st.end(), Type(0));
+			silence.reset();
 		}
 
 	private:
+		static constexpr size_t laneWidth = simd::Batch<Type>::size;
+		static constexpr size_t chunkSize = 64;
+
+		//==============================================================================
+		Type& s1(size_t ch) noexcept { return st[2 * ch - ch % laneWidth]; }
+
+		Type& s2(size_t ch) noexcept { return st[2 * ch - ch % laneWidth + laneWidth]; }
+
+		void skip(Type* output, size_t ch, size_t nFrames) noexcept
+		{
+			std::fill_n(output, nFrames, Type(0));
+			s1(ch) = s2(ch) = 0;
+		}
+
+		//==============================================================================
+		void applyParameters() noexcept
+		{
+			// Only the trigonometry or the gain terms that are actually stale are recomputed.
+			bool freqChanged = false, gainChanged = false;
+			const bool changed = events.drain([&](size_t id, Type value)
+			{
+				switch (static_cast<RBJFilterParameter>(id))
+				{
+				case RBJFilterParameter::cutoff: cutoff = value; freqChanged = true; break;
+				case RBJFilterParameter::Q: R = 1 / (value + value); break;
+				case RBJFilterParameter::gain: gainInDb = value; gainChanged = true; break;
+				case RBJFilterParameter::type: type = static_cast<FilterType>(static_cast<int>(value)); break;
+				}
+			});
+
+			if (!changed) return;
+
+			if (freqChanged && gainChanged) update<true, true>();
+			else if (freqChanged) update<true, false>();
+			else if (gainChanged) update<false, true>();
+			else update<false, false>();
+		}
+
 		template <bool updateFreqParams, bool updateGainParams>
 		void update() noexcept
 		{
@@ -127,89 +455,12 @@ namespace hexa
 
 			alpha = sinw0 * R;
 
-			Type b0, b1, b2, a0, a1, a2;
-			switch (type)
-			{
-			case FilterType::LP:
-				b0 = (1 - cosw0) / 2;
-				b1 = 1 - cosw0;
-				b2 = (1 - cosw0) / 2;
-				a0 = 1 + alpha;
-				a1 = -2 * cosw0;
-				a2 = 1 - alpha;
-				break;
-			case FilterType::BP:
-				b0 = sinw0 / 2;
-				b1 = 0;
-				b2 = -sinw0 / 2.;
-				a0 = 1 + alpha;
-				a1 = -2 * cosw0;
-				a2 = 1 - alpha;
-				break;
-			case FilterType::HP:
-				b0 = (1 + cosw0) / 2;
-				b1 = -(1 + cosw0);
-				b2 = (1 + cosw0) / 2;
-				a0 = 1 + alpha;
-				a1 = -2 * cosw0;
-				a2 = 1 - alpha;
-				break;
-			case FilterType::BP1:
-				b0 = alpha;
-				b1 = 0;
-				b2 = -alpha;
-				a0 = 1 + alpha;
-				a1 = -2 * cosw0;
-				a2 = 1 - alpha;
-				break;
-			case FilterType::LS:
-				b0 = A * ((A + 1) - (A - 1) * cosw0 + 2 * ASqRt * alpha);
-				b1 = 2 * A * ((A - 1) - (A + 1) * cosw0);
-				b2 = A * ((A + 1) - (A - 1) * cosw0 - 2 * ASqRt * alpha);
-				a0 = (A + 1) + (A - 1) * cosw0 + 2 * ASqRt * alpha;
-				a1 = -2 * ((A - 1) + (A + 1) * cosw0);
-				a2 = (A + 1) + (A - 1) * cosw0 - 2 * ASqRt * alpha;
-				break;
-			case FilterType::HS:
-				b0 = A * ((A + 1) + (A - 1) * cosw0 + 2 * ASqRt * alpha);
-				b1 = -2 * A * ((A - 1) + (A + 1) * cosw0);
-				b2 = A * ((A + 1) + (A - 1) * cosw0 - 2 * ASqRt * alpha);
-				a0 = (A + 1) - (A - 1) * cosw0 + 2 * ASqRt * alpha;
-				a1 = 2 * ((A - 1) - (A + 1) * cosw0);
-				a2 = (A + 1) - (A - 1) * cosw0 - 2 * ASqRt * alpha;
-				break;
-			case FilterType::peak:
-				b0 = 1 + 1 * alpha * A;
-				b1 = -2 * cosw0;
-				b2 = 1 - 1 * alpha * A;
-				a0 = 1 + alpha / A;
-				a1 = -2 * cosw0;
-				a2 = 1 - alpha / A;
-				break;
-			case FilterType::notch:
-				b0 = 1;
-				b1 = -2 * cosw0;
-				b2 = 1;
-				a0 = 1 + alpha;
-				a1 = -2 * cosw0;
-				a2 = 1 - alpha;
-				break;
-			case FilterType::AP:
-				b0 = 1 - alpha;
-				b1 = -2 * cosw0;
-				b2 = 1 + alpha;
-				a0 = 1 + alpha;
-				a1 = -2 * cosw0;
-				a2 = 1 - alpha;
-				break;
-			}
-
-			// Calculate bi-quad coefficients
-			a1Da0 = a1 / a0;
-			a2Da0 = a2 / a0;
-			b0Da0 = b0 / a0;
-			b1Da0 = b1 / a0;
-			b2Da0 = b2 / a0;
+			const auto coeffs = designRBJ(type, cosw0, sinw0, alpha, A, ASqRt);
+			a1Da0 = coeffs.a1;
+			a2Da0 = coeffs.a2;
+			b0Da0 = coeffs.b0;
+			b1Da0 = coeffs.b1;
+			b2Da0 = coeffs.b2;
 		}
 
 		Type tick(const Type& x, Type& s1, Type& s2)
@@ -230,6 +481,125 @@ namespace hexa
 		Type a1Da0{}, a2Da0{}, b0Da0{}, b1Da0{}, b2Da0{};
 
 		//==============================================================================
-		std::vector<Type> st1{ 2 }, st2{ 2 };
+		size_t numChans{ 2 };
+		std::vector<Type> st = std::vector<Type>(2 * utils::alignUp(numChans, laneWidth));
+
+		DenormalProtection<Type> denormals{};
+		SilenceGate<Type> silence{};
+
+		ParameterQueue<Type, 4> events{};
+	};
+
+	//==============================================================================
+	/**
+	 * RBJFilter with all settings fixed at compile time (DC blockers, fixed crossovers,
+	 * de-emphasis ...). The coefficients are constants designed in double by
+	 * designRBJConstexpr, so there is no update() at all and multiplications by 0 or 1
+	 * fold away. Q and gain are std::ratio, e.g. std::ratio<1, 2> for Q = 0.5.
+	 *
+	 * @code
+	 *	hexa::FixedRBJFilter<float, hexa::RBJFilterType::HP, 10, std::ratio<1, 2>, 48000> dcBlocker;
+	 * @endcode
+	 */
+	template <typename Type, RBJFilterType type, unsigned cutoffHz, typename Q = std::ratio<7071, 10000>,
+		unsigned sampleRateHz = 48000, typename GainDb = std::ratio<0>>
+	class FixedRBJFilter final
+	{
+		static_assert(cutoffHz > 0 && 2 * cutoffHz < sampleRateHz, "Cutoff needs to be in (0, sampleRate / 2)");
+		static_assert(Q::num > 0, "Q needs to be positive");
+
+		static constexpr BiquadCoefficients<double> design = designRBJConstexpr(type, double(cutoffHz),
+			1 / (2 * utils::ratioValue<Q>()), utils::ratioValue<GainDb>(), double(sampleRateHz));
+
+	public:
+		static constexpr Type b0 = Type(design.b0), b1 = Type(design.b1), b2 = Type(design.b2);
+		static constexpr Type a1 = Type(design.a1), a2 = Type(design.a2);
+
+		//==============================================================================
+		static constexpr RBJFilterType getType() noexcept { return type; }
+
+		static constexpr Type getCutoff() noexcept { return Type(cutoffHz); }
+
+		static constexpr Type getSampleRate() noexcept { return Type(sampleRateHz); }
+
+		//==============================================================================
+		/** See DenormalMode. */
+		void setDenormalMode(DenormalMode newMode) noexcept { denormals.setMode(newMode); }
+
+		DenormalMode getDenormalMode() const noexcept { return denormals.getMode(); }
+
+		//==============================================================================
+		/** Only allocates the states, sRate has to be the one the filter is designed for. */
+		void prepare([[maybe_unused]] Type sRate, size_t numChannels, [[maybe_unused]] size_t maxBlockSize)
+		{
+			assert(sRate == Type(sampleRateHz));
+			s1.resize(numChannels);
+			s2.resize(numChannels);
+			reset();
+		}
+
+		/** Denormal scope of a block, see Chain::beginBlock(). */
+		auto beginBlock() noexcept
+		{
+			return denormals.protect(s1, s2);
+		}
+
+		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
+		{
+			assert(nChans <= s1.size());
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			for (size_t ch = 0; ch < nChans; ++ch)
+			{
+				Type ls1 = s1[ch], ls2 = s2[ch];
+
+				const Type* in = inputs[ch];
+				Type* out = outputs[ch];
+
+				for (size_t n = 0; n < nFrames; ++n)
+				{
+					out[n] = tick(in[n] + dc, ls1, ls2);
+				}
+
+				s1[ch] = ls1; s2[ch] = ls2;
+			}
+		}
+
+		Type processSample(const Type& x, size_t ch) noexcept
+		{
+			assert(ch < s1.size());
+			return tick(x, s1[ch], s2[ch]);
+		}
+
+		// Same as processSample (introduced for brevity in complex processors), plus the input
+		// offset of an open denormal scope
+		Type operator() (const Type& x, size_t ch) noexcept
+		{
+			return processSample(x + denormals.getInputOffset(), ch);
+		}
+
+		void reset() noexcept
+		{
+			std::fill(s1.begin(), s1.end(), Type(0));
+			std::fill(s2.begin(), s2.end(), Type(0));
+		}
+
+	private:
+		static Type tick(const Type& x, Type& s1, Type& s2) noexcept
+		{
+			// Transposed canonical form (TDF-II), same as RBJFilter::tick.
+			Type y = b0 * x + s1;
+
+			s1 = b1 * x - a1 * y + s2;
+			s2 = b2 * x - a2 * y;
+
+			return y;
+		}
+
+		std::vector<Type> s1 = std::vector<Type>(2), s2 = std::vector<Type>(2);
+
+		DenormalProtection<Type> denormals{};
 	};
-}
\ No newline at end of file
+}
@@ -4,12 +4,18 @@
 #include <cassert>
 #include <vector>
 
+#include "../core/hexa_Denormals.h"
+#include "../core/hexa_ParameterQueue.h"
+#include "../core/hexa_Silence.h"
+#include "hexa_FrequencyResponse.h"
 #include "hexa_Prewarpers.h"
 
 namespace hexa
 {
 	enum class SallenKeyFilterType { LP, HP, BP, BP1 };
 
+	enum class SallenKeyParameter { frequency, resonance, type };
+
 	/**
 	 * MIMO realization of a linear Sallen-Key filter
 	 */
@@ -39,15 +45,60 @@ namespace hexa
 			update<true, true, true>();
 		}
 
+		/**
+		 * Lock-free change from one control thread, applied at the start of the next process()
+		 * (the type goes as Type(SallenKeyFilterType)).
+		 */
+		void postParameter(SallenKeyParameter id, Type value) noexcept
+		{
+			events.push(static_cast<size_t>(id), value);
+		}
+
 		//==============================================================================
 		Type getCutoff() const noexcept { return cutoff; }
 
 		Type getResonance() const noexcept { return reso; }
 
-		Type getType() const noexcept { return type; }
+		FilterType getType() const noexcept { return type; }
 
 		Type getSampleRate() const noexcept { return sampleRate; }
 
+		//==============================================================================
+		/** The current coefficients as a z-domain bi-quad (changes still queued by postParameter() not included). */
+		BiquadCoefficients<Type> getTransferFunction() const noexcept
+		{
+			return response::fromStateSpace(m11, m12, m21, m22, g * (a1 - a2), g * a2, c1, c2, c0);
+		}
+
+		/** |H| at n frequencies in Hz, vectorized over the bins. */
+		void getMagnitudeResponse(const Type* freqs, Type* mags, size_t n) const noexcept
+		{
+			response::magnitude(getTransferFunction(), sampleRate, freqs, mags, n);
+		}
+
+		/** arg H in radians at n frequencies in Hz, vectorized over the bins. */
+		void getPhaseResponse(const Type* freqs, Type* phases, size_t n) const noexcept
+		{
+			response::phase(getTransferFunction(), sampleRate, freqs, phases, n);
+		}
+
+		//==============================================================================
+		/** See DenormalMode. */
+		void setDenormalMode(DenormalMode newMode) noexcept { denormals.setMode(newMode); }
+
+		DenormalMode getDenormalMode() const noexcept { return denormals.getMode(); }
+
+		//==============================================================================
+		/** Skips the silent channels of process(), see SilenceGate. */
+		void setSilenceBypass(bool shouldBypass) noexcept { silence.setEnabled(shouldBypass); }
+
+		void setSilenceThreshold(Type newThreshold) noexcept { silence.setThreshold(newThreshold); }
+
+		bool isSilenceBypassEnabled() const noexcept { return silence.isEnabled(); }
+
+		/** Samples for the impulse response to decay by 120 dB, exact from the poles. */
+		size_t getTailLength() const noexcept { return response::tailLength(getTransferFunction()); }
+
 		//==============================================================================
 		void prepare(Type sRate, size_t numChannels, [[maybe_unused]] size_t maxBlockSize) noexcept
 		{
@@ -58,16 +109,36 @@ namespace hexa
 			st2.resize(numChannels);
 
 			update<true, true, true>();
+			silence.prepare(numChannels);
 			reset();
 		}
 
+		/** Posted parameters and denormal scope of a block, see Chain::beginBlock(). */
+		auto beginBlock() noexcept
+		{
+			applyParameters();
+			return denormals.protect(st1, st2);
+		}
+
 		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
 		{
 			assert(nChans <= st1.size());
 			assert(nChans <= st2.size());
 
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			const size_t tail = silence.isEnabled() ? getTailLength() : 0;
+
 			for (size_t ch = 0; ch < nChans; ++ch)
 			{
+				if (silence.canSkip(ch, inputs[ch], nFrames, tail))
+				{
+					std::fill_n(outputs[ch], nFrames, Type(0));
+					st1[ch] = st2[ch] = 0;
+					continue;
+				}
+
 				auto&& ls1 = st1[ch];
 				auto&& ls2 = st2[ch];
 
@@ -76,11 +147,30 @@ namespace hexa
 
 				for (size_t n = 0; n < nFrames; ++n)
 				{
-					out[n] = tick(in[n], ls1, ls2);
+					out[n] = tick(in[n] + dc, ls1, ls2);
 				}
 			}
 		}
 
+		/** Processes interleaved stereo frames (L R L R ...), no transpose to planar needed. */
+		void processInterleavedStereo(const Type* input, Type* output, size_t nFrames) noexcept
+		{
+			assert(st1.size() >= 2 && st2.size() >= 2);
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			Type l1 = st1[0], l2 = st2[0], r1 = st1[1], r2 = st2[1];
+
+			for (size_t n = 0; n < 2 * nFrames; n += 2)
+			{
+				output[n] = tick(input[n] + dc, l1, l2);
+				output[n + 1] = tick(input[n + 1] + dc, r1, r2);
+			}
+
+			st1[0] = l1; st2[0] = l2; st1[1] = r1; st2[1] = r2;
+		}
+
 		Type processSample(const Type& x, size_t ch)
 		{
 			assert(ch < st1.size());
@@ -88,21 +178,38 @@ namespace hexa
 			return tick(x, st1[ch], st2[ch]);
 		}
 
-		// Same as processSample (introduced for brevity in complex processors)
+		// Same as processSample (introduced for brevity in complex processors), plus the input
+		// offset of an open denormal scope
 		Type operator() (const Type& x, size_t ch)
 		{
 			assert(ch < st1.size());
 			assert(ch < st2.size());
-			return tick(x, st1[ch], st2[ch]);
+			return tick(x + denormals.getInputOffset(), st1[ch], st2[ch]);
 		}
 
 		void reset() noexcept
 		{
 			std::fill(st1.begin(), st1.end(), Type(0));
 			std::fill(st2.begin(), st2.end(), Type(0));
+			silence.reset();
 		}
 
 	private:
+		void applyParameters() noexcept
+		{
+			const bool changed = events.drain([this](size_t id, Type value)
+			{
+				switch (static_cast<SallenKeyParameter>(id))
+				{
+				case SallenKeyParameter::frequency: cutoff = std::clamp(value, Type(5), Type(20.e3)); break;
+				case SallenKeyParameter::resonance: reso = std::clamp(value, Type(0), Type(1)); break;
+				case SallenKeyParameter::type: type = static_cast<FilterType>(static_cast<int>(value)); break;
+				}
+			});
+
+			if (changed) update<true, true, true>();
+		}
+
 		Type tick(const Type& x, Type& s1, Type& s2) noexcept
 		{
 			// RHS
@@ -172,6 +279,11 @@ namespace hexa
 		Type c0{}, c1{}, c2{};
 		std::vector<Type> st1{ 2 }, st2{ 2 };
 
-		Prewarper<Type> pw;
+		DenormalProtection<Type> denormals{};
+		SilenceGate<Type> silence{};
+
+		Prewarper pw{};
+
+		ParameterQueue<Type, 3> events{};
 	};
 }
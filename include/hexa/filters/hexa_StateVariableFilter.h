@@ -4,14 +4,97 @@
 #include <cassert>
 #include <vector>
 
+#include "../core/hexa_DataBuffer.h"
+#include "../core/hexa_Denormals.h"
 #include "../core/hexa_General.h"
+#include "../core/hexa_ParameterQueue.h"
+#include "../core/hexa_Silence.h"
+#include "../core/hexa_Simd.h"
 #include "../math/hexa_Constants.h"
+#include "../math/hexa_Series.h"
+#include "hexa_FrequencyResponse.h"
 #include "hexa_Prewarpers.h"
 
 namespace hexa
 {
 	enum class StateVariableType { HP, BP, BP1, LP, AP, LS, HS, tilt, BS };
 
+	enum class StateVariableParameter { cutoff, Q, bandWidth, gain, type };
+
+	/** Coefficients of the state variable filter: LU terms of the trapezoidal step and the output mix. */
+	template <typename Type>
+	struct StateVariableCoefficients
+	{
+		Type g{}, l21{}, u11Inv{}, u22Inv{}, u12u22Inv{}, a1{}, a2{}, a0{};
+	};
+
+	/**
+	 * State variable filter design from the prewarped cutoff gc, R2 = 1 / Q and the gain term
+	 * A = 10^(dB / 80) (the shelves scale the cutoff by A, the tilt by A^2).
+	 */
+	template <typename Type>
+	constexpr StateVariableCoefficients<Type> designSVF(StateVariableType type, Type gc, Type R2, Type A) noexcept
+	{
+		Type g = gc, a1{}, a2{}, a0{};
+		const Type A2 = A * A, A4 = A2 * A2;
+
+		switch (type)
+		{
+		case StateVariableType::LS:
+			g = gc / A;
+			a1 = R2 * A2 - R2;
+			a2 = A4 - 1;
+			a0 = 1;
+			break;
+		case StateVariableType::HS:
+			g = gc * A;
+			a1 = A2 * (1 - A2) * R2;
+			a2 = 1 - A4;
+			a0 = A4;
+			break;
+		case StateVariableType::tilt:
+			g = gc * A2;
+			a1 = (1 - A4) * R2;
+			a2 = 1 / A4 - A4;
+			a0 = A4;
+			break;
+		case StateVariableType::BS:
+			a1 = (A2 - 1 / A2) * R2;
+			a2 = 0;
+			a0 = 1;
+			break;
+		case StateVariableType::HP:
+			a1 = -R2;
+			a2 = -1;
+			a0 = 1;
+			break;
+		case StateVariableType::BP:
+			a1 = 1;
+			a2 = 0;
+			a0 = 0;
+			break;
+		case StateVariableType::BP1:
+			a1 = R2;
+			a2 = 0;
+			a0 = 0;
+			break;
+		case StateVariableType::LP:
+			a1 = 0;
+			a2 = 1;
+			a0 = 0;
+			break;
+		case StateVariableType::AP:
+			a1 = -2 * R2;
+			a2 = 0;
+			a0 = 1;
+			break;
+		}
+
+		const Type g1 = R2 * g + 1;
+		const Type u22Inv = g1 / (g * (R2 + g) + 1);
+		return { g, -g / g1, 1 / g1, u22Inv, g * u22Inv, a1, a2, a0 };
+	}
+
 	template <typename Type, typename Prewarper = TaylorPrewarper<Type>>
 	class StateVariableFilter final
 	{
@@ -39,10 +122,7 @@ namespace hexa
 
 		void setBandWidth(Type newBW) noexcept
 		{
-			Type bw = std::clamp(newBW, Type(0.1), Type(3));
-
-			Type bwM = std::exp2(bw / 2);
-			Type newR2 = 2 * std::sinh(std::log2(pw.g(cutoff * bwM) / pw.g(cutoff / bwM)) * c<Type>::ln2 / 2);
+			Type newR2 = bandWidthToR2(newBW);
 			if (utils::areSame(newR2, R2)) return;
 
 			R2 = newR2;
@@ -63,6 +143,15 @@ namespace hexa
 			update();
 		}
 
+		/**
+		 * Lock-free change from one control thread, applied at the start of the next process()
+		 * (the type goes as Type(StateVariableType)).
+		 */
+		void postParameter(StateVariableParameter id, Type value) noexcept
+		{
+			events.push(static_cast<size_t>(id), value);
+		}
+
 		//==============================================================================		
 		Type getCutoff() const noexcept { return cutoff; }
 
@@ -70,13 +159,52 @@ namespace hexa
 
 		Type getGain() const noexcept { return gain; }
 
-		Type getType() const noexcept { return type; }
+		FilterType getType() const noexcept { return type; }
 
 		Type getSampleRate() const noexcept { return sampleRate; }
 
 
+		//==============================================================================
+		/** The current coefficients as a z-domain bi-quad (changes still queued by postParameter() not included). */
+		BiquadCoefficients<Type> getTransferFunction() const noexcept
+		{
+			// u = M * b, from the LU solve in tick()
+			const Type m11 = u11Inv * (1 + u12u22Inv * l21), m12 = -u11Inv * u12u22Inv;
+			const Type m21 = -l21 * u22Inv, m22 = u22Inv;
+			return response::fromStateSpace(m11, m12, m21, m22, g, Type(0), a1, a2, a0);
+		}
+
+		/** |H| at n frequencies in Hz, vectorized over the bins. */
+		void getMagnitudeResponse(const Type* freqs, Type* mags, size_t n) const noexcept
+		{
+			response::magnitude(getTransferFunction(), sampleRate, freqs, mags, n);
+		}
+
+		/** arg H in radians at n frequencies in Hz, vectorized over the bins. */
+		void getPhaseResponse(const Type* freqs, Type* phases, size_t n) const noexcept
+		{
+			response::phase(getTransferFunction(), sampleRate, freqs, phases, n);
+		}
+
+		//==============================================================================
+		/** See DenormalMode. */
+		void setDenormalMode(DenormalMode newMode) noexcept { denormals.setMode(newMode); }
+
+		DenormalMode getDenormalMode() const noexcept { return denormals.getMode(); }
+
+		//==============================================================================
+		/** Skips the silent channels of process(), see SilenceGate. */
+		void setSilenceBypass(bool shouldBypass) noexcept { silence.setEnabled(shouldBypass); }
+
+		void setSilenceThreshold(Type newThreshold) noexcept { silence.setThreshold(newThreshold); }
+
+		bool isSilenceBypassEnabled() const noexcept { return silence.isEnabled(); }
+
+		/** Samples for the impulse response to decay by 120 dB, exact from the poles. */
+		size_t getTailLength() const noexcept { return response::tailLength(getTransferFunction()); }
+
 		//==============================================================================		
-		void prepare(Type sRate, size_t numChannels, [[maybe_unused]] size_t maxBlockSize) noexcept
+		void prepare(Type sRate, size_t numChannels, size_t maxBlockSize) noexcept
 		{
 			sampleRate = sRate;
 			pw.setup(sampleRate);
@@ -84,17 +212,39 @@ namespace hexa
 			s1.resize(numChannels);
 			s2.resize(numChannels);
 
+			modCoeffs.resize(std::max(maxBlockSize, size_t(1)), numModCoeffs);
+
 			update();
+			silence.prepare(numChannels);
 			reset();
 		}
 
+		/** Posted parameters and denormal scope of a block, see Chain::beginBlock(). */
+		auto beginBlock() noexcept
+		{
+			applyParameters();
+			return denormals.protect(s1, s2);
+		}
+
 		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
 		{
 			assert(nChans <= s1.size());
 			assert(nChans <= s2.size());
 
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			const size_t tail = silence.isEnabled() ? getTailLength() : 0;
+
 			for (size_t ch = 0; ch < nChans; ++ch)
 			{
+				if (silence.canSkip(ch, inputs[ch], nFrames, tail))
+				{
+					std::fill_n(outputs[ch], nFrames, Type(0));
+					s1[ch] = s2[ch] = 0;
+					continue;
+				}
+
 				auto&& ls1 = s1[ch];
 				auto&& ls2 = s2[ch];
 
@@ -103,11 +253,76 @@ namespace hexa
 
 				for (size_t n = 0; n < nFrames; ++n)
 				{
-					out[n] = tick(in[n], ls1, ls2);
+					out[n] = tick(in[n] + dc, ls1, ls2);
+				}
+			}
+		}
+
+		/** Processes interleaved stereo frames (L R L R ...), no transpose to planar needed. */
+		void processInterleavedStereo(const Type* input, Type* output, size_t nFrames) noexcept
+		{
+			assert(s1.size() >= 2 && s2.size() >= 2);
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			Type l1 = s1[0], l2 = s2[0], r1 = s1[1], r2 = s2[1];
+
+			for (size_t n = 0; n < 2 * nFrames; n += 2)
+			{
+				output[n] = tick(input[n] + dc, l1, l2);
+				output[n + 1] = tick(input[n + 1] + dc, r1, r2);
+			}
+
+			s1[0] = l1; s2[0] = l2; s1[1] = r1; s2[1] = r2;
+		}
+
+		/**
+		 * Processes a block with a per-sample cutoff (and optionally Q) shared by all channels.
+		 * The coefficients for the block are computed in one vectorized batch instead of
+		 * an update() per sample; cutoff/Q set with the setters are left untouched.
+		 */
+		void processModulated(const Type** inputs, Type** outputs, const Type* cutoffs, const Type* Qs,
+			size_t nChans, size_t nFrames) noexcept
+		{
+			assert(nChans <= s1.size());
+			assert(nChans <= s2.size());
+			assert(cutoffs != nullptr);
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			const size_t maxLen = modCoeffs.getNumRows();
+			for (size_t start = 0; start < nFrames; start += maxLen)
+			{
+				const size_t len = std::min(maxLen, nFrames - start);
+				updateModulated(cutoffs + start, Qs != nullptr ? Qs + start : nullptr, len);
+
+				const Type* lg = modCoeffs.col(0);
+				const Type* ll21 = modCoeffs.col(1);
+				const Type* lu11Inv = modCoeffs.col(2);
+				const Type* lu22Inv = modCoeffs.col(3);
+				const Type* lu12u22Inv = modCoeffs.col(4);
+				const Type* la1 = modCoeffs.col(5);
+
+				// Channels in the inner loop: the tick is latency bound, so independent
+				// channels overlap and the per-sample coefficients are loaded once.
+				for (size_t n = 0; n < len; ++n)
+				{
+					for (size_t ch = 0; ch < nChans; ++ch)
+					{
+						outputs[ch][start + n] = tick(inputs[ch][start + n] + dc, s1[ch], s2[ch],
+							lg[n], ll21[n], lu11Inv[n], lu22Inv[n], lu12u22Inv[n], la1[n]);
+					}
 				}
 			}
 		}
 
+		void processModulated(const Type** inputs, Type** outputs, const Type* cutoffs, size_t nChans, size_t nFrames) noexcept
+		{
+			processModulated(inputs, outputs, cutoffs, nullptr, nChans, nFrames);
+		}
+
 		Type processSample(const Type& x, size_t ch)
 		{
 			assert(ch < s1.size());
@@ -115,22 +330,50 @@ namespace hexa
 			return tick(x, s1[ch], s2[ch]);
 		}
 
-		// Same as processSample (introduced for brevity in complex processors)
+		// Same as processSample (introduced for brevity in complex processors), plus the input
+		// offset of an open denormal scope
 		Type operator() (const Type& x, size_t ch)
 		{
 			assert(ch < s1.size());
 			assert(ch < s2.size());
-			return tick(x, s1[ch], s2[ch]);
+			return tick(x + denormals.getInputOffset(), s1[ch], s2[ch]);
 		}
 
 		void reset() noexcept
 		{
 			std::fill(s1.begin(), s1.end(), Type(0));
 			std::fill(s2.begin(), s2.end(), Type(0));
+			silence.reset();
 		}
 
 	private:
+		static constexpr size_t numModCoeffs = 6;
+
+		//==============================================================================
+		void applyParameters() noexcept
+		{
+			// In id order, so a bandwidth is taken relative to a cutoff queued with it.
+			const bool changed = events.drain([this](size_t id, Type value)
+			{
+				switch (static_cast<StateVariableParameter>(id))
+				{
+				case StateVariableParameter::cutoff: cutoff = std::clamp(value, Type(5.), Type(20.e3)); break;
+				case StateVariableParameter::Q: R2 = 1 / std::clamp(value, Type(0.001), Type(72)); break;
+				case StateVariableParameter::bandWidth: R2 = bandWidthToR2(value); break;
+				case StateVariableParameter::gain: gain = std::clamp(value, Type(-48.), Type(48.)); break;
+				case StateVariableParameter::type: type = static_cast<FilterType>(static_cast<int>(value)); break;
+				}
+			});
+
+			if (changed) update();
+		}
+
 		Type tick(const Type& x, Type& s1, Type& s2)
+		{
+			return tick(x, s1, s2, g, l21, u11Inv, u22Inv, u12u22Inv, a1);
+		}
+
+		Type tick(const Type& x, Type& s1, Type& s2, Type g, Type l21, Type u11Inv, Type u22Inv, Type u12u22Inv, Type a1)
 		{
 			Type b1 = g * x + s1, b2 = s2;
 
@@ -145,154 +388,255 @@ namespace hexa
 			return a1 * u1 + a2 * u2 + a0 * x;
 		}
 
-		//==============================================================================		
-		void update() noexcept
+		//==============================================================================
+		/** Terms of the LU factorization, written for both Type and simd::Batch<Type>. */
+		template <typename V>
+		static void luTerms(V g, V R2, V one, V& l21, V& u11Inv, V& u22Inv, V& u12u22Inv) noexcept
 		{
-			Type m, m2, g1;
+			V g1 = R2 * g + one;
+			l21 = -g / g1;
+			u11Inv = one / g1;
+			u22Inv = g1 / (g * (R2 + g) + one);
+			u12u22Inv = g * u22Inv;
+		}
+
+		/**
+		 * Splits the type dependent part of update() into the terms that do not change
+		 * with cutoff and Q: g = pw.g(cutoff) * gScale, a1 = a1R * R2 + a1C.
+		 */
+		void getModulationTerms(Type& gScale, Type& a1R, Type& a1C) const noexcept
+		{
+			Type m, m2;
+			gScale = 1; a1R = 0; a1C = 0;
 			switch (type)
 			{
 			case FilterType::LS:
 				m = std::pow(Type(10), -gain / 80); m2 = m * m;
-				g = pw.g(cutoff) * m;
-
-				g1 = R2 * g + 1;
-				l21 = -g / g1;
-				u11Inv = 1 / g1;
-				u22Inv = g1 / (g * (R2 + g) + 1);
-				u12u22Inv = g * u22Inv;
-
-				a1 = R2 / m2 - R2;
-				a2 = 1 / (m2 * m2) - 1;
-				a0 = 1;
-
+				gScale = m; a1R = 1 / m2 - 1;
 				break;
 			case FilterType::HS:
 				m = std::pow(Type(10), gain / 80); m2 = m * m;
-				g = pw.g(cutoff) * m;
-
-				g1 = R2 * g + 1;
-				l21 = -g / g1;
-				u11Inv = 1 / g1;
-				u22Inv = g1 / (g * (R2 + g) + 1);
-				u12u22Inv = g * u22Inv;
-
-				a1 = m2 * (1 - m2) * R2;
-				a2 = 1 - m2 * m2;
-				a0 = m2 * m2;
-
+				gScale = m; a1R = m2 * (1 - m2);
 				break;
 			case FilterType::tilt:
 				m = std::pow(Type(10), gain / 40); m2 = m * m;
-				g = pw.g(cutoff) * m;
-
-				g1 = R2 * g + 1;
-				l21 = -g / g1;
-				u11Inv = 1 / g1;
-				u22Inv = g1 / (g * (R2 + g) + 1);
-				u12u22Inv = g * u22Inv;
-
-				a1 = (1 - m2) * R2;
-				a2 = 1 / m2 - m2;
-				a0 = m2;
-
+				gScale = m; a1R = 1 - m2;
 				break;
 			case FilterType::BS:
 				m = std::pow(Type(10), -gain / 40);
-				g = pw.g(cutoff);
+				a1R = 1 / m - m;
+				break;
+			case FilterType::HP: a1R = -1; break;
+			case FilterType::BP: a1R = 0; a1C = 1; break;
+			case FilterType::BP1: a1R = 1; break;
+			case FilterType::LP: a1R = 0; break;
+			case FilterType::AP: a1R = -2; break;
+			}
+		}
 
-				g1 = R2 * g + 1;
-				l21 = -g / g1;
-				u11Inv = 1 / g1;
-				u22Inv = g1 / (g * (R2 + g) + 1);
-				u12u22Inv = g * u22Inv;
+		/** Fills modCoeffs with per-sample g, l21, u11Inv, u22Inv, u12u22Inv and a1. */
+		void updateModulated(const Type* cutoffs, const Type* Qs, size_t len) noexcept
+		{
+			using Batch = simd::Batch<Type>;
 
-				a1 = (1 / m - m) * R2;
-				a2 = 0;
-				a0 = 1;
+			Type gScale, a1R, a1C;
+			getModulationTerms(gScale, a1R, a1C);
 
-				break;
-			case FilterType::HP:
-				g = pw.g(cutoff);
+			Type* lg = modCoeffs.col(0);
+			Type* ll21 = modCoeffs.col(1);
+			Type* lu11Inv = modCoeffs.col(2);
+			Type* lu22Inv = modCoeffs.col(3);
+			Type* lu12u22Inv = modCoeffs.col(4);
+			Type* la1 = modCoeffs.col(5);
 
-				g1 = R2 * g + 1;
-				l21 = -g / g1;
-				u11Inv = 1 / g1;
-				u22Inv = g1 / (g * (R2 + g) + 1);
-				u12u22Inv = g * u22Inv;
+			// R2 goes to la1 temporarily, so both paths below read it from memory.
+			for (size_t n = 0; n < len; ++n)
+			{
+				lg[n] = std::clamp(cutoffs[n], Type(5.), Type(20.e3));
+				la1[n] = Qs != nullptr ? 1 / std::clamp(Qs[n], Type(0.001), Type(72)) : R2;
+			}
 
-				a1 = -R2;
-				a2 = -1;
-				a0 = 1;
+			pw.g(lg, lg, len);
 
-				break;
-			case FilterType::BP:
-				g = pw.g(cutoff);
+			const size_t vecLen = utils::roundDownToMultiple(len, Batch::size);
+			const auto one = Batch::broadcast(1), vgScale = Batch::broadcast(gScale);
+			const auto va1R = Batch::broadcast(a1R), va1C = Batch::broadcast(a1C);
+			for (size_t n = 0; n < vecLen; n += Batch::size)
+			{
+				Batch vl21, vu11Inv, vu22Inv, vu12u22Inv;
+				const auto vg = Batch::load(lg + n) * vgScale;
+				const auto vR2 = Batch::load(la1 + n);
+				luTerms(vg, vR2, one, vl21, vu11Inv, vu22Inv, vu12u22Inv);
+
+				vg.store(lg + n);
+				vl21.store(ll21 + n);
+				vu11Inv.store(lu11Inv + n);
+				vu22Inv.store(lu22Inv + n);
+				vu12u22Inv.store(lu12u22Inv + n);
+				(va1R * vR2 + va1C).store(la1 + n);
+			}
 
-				g1 = R2 * g + 1;
-				l21 = -g / g1;
-				u11Inv = 1 / g1;
-				u22Inv = g1 / (g * (R2 + g) + 1);
-				u12u22Inv = g * u22Inv;
+			for (size_t n = vecLen; n < len; ++n)
+			{
+				lg[n] *= gScale;
+				luTerms(lg[n], la1[n], Type(1), ll21[n], lu11Inv[n], lu22Inv[n], lu12u22Inv[n]);
+				la1[n] = a1R * la1[n] + a1C;
+			}
+		}
 
-				a1 = 1;
-				a2 = 0;
-				a0 = 0;
+		//==============================================================================		
+		Type bandWidthToR2(Type newBW) const noexcept
+		{
+			Type bw = std::clamp(newBW, Type(0.1), Type(3));
 
-				break;
-			case FilterType::BP1:
-				g = pw.g(cutoff);
+			Type bwM = std::exp2(bw / 2);
+			return 2 * std::sinh(std::log2(pw.g(cutoff * bwM) / pw.g(cutoff / bwM)) * c<Type>::ln2 / 2);
+		}
 
-				g1 = R2 * g + 1;
-				l21 = -g / g1;
-				u11Inv = 1 / g1;
-				u22Inv = g1 / (g * (R2 + g) + 1);
-				u12u22Inv = g * u22Inv;
+		void update() noexcept
+		{
+			const auto coeffs = designSVF(type, pw.g(cutoff), R2, std::pow(Type(10), gain / 80));
+			g = coeffs.g;
+			l21 = coeffs.l21;
+			u11Inv = coeffs.u11Inv;
+			u22Inv = coeffs.u22Inv;
+			u12u22Inv = coeffs.u12u22Inv;
+			a1 = coeffs.a1;
+			a2 = coeffs.a2;
+			a0 = coeffs.a0;
+		}
 
-				a1 = R2;
-				a2 = 0;
-				a0 = 0;
+		//==============================================================================		
+		Type sampleRate{ 44100. }, cutoff{ 440. }, gain{ 6. }, R2{ c<Type>::sqrt2 };
+		FilterType type{ FilterType::LP };
 
-				break;
-			case FilterType::LP:
-				g = pw.g(cutoff);
+		Type g{}, a1{}, a2{}, a0{};
+		Type l21{}, u11Inv{}, u22Inv{}, u12u22Inv{};
 
-				g1 = R2 * g + 1;
-				l21 = -g / g1;
-				u11Inv = 1 / g1;
-				u22Inv = g1 / (g * (R2 + g) + 1);
-				u12u22Inv = g * u22Inv;
+		std::vector<Type> s1{ 2 }, s2{ 2 };
 
-				a1 = 0;
-				a2 = 1;
-				a0 = 0;
+		DenormalProtection<Type> denormals{};
+		SilenceGate<Type> silence{};
 
-				break;
-			case FilterType::AP:
-				g = pw.g(cutoff);
+		// Per-sample coefficients for processModulated
+		DataBuffer<Type> modCoeffs{ 32, numModCoeffs };
+
+		Prewarper pw{};
 
-				g1 = R2 * g + 1;
-				l21 = -g / g1;
-				u11Inv = 1 / g1;
-				u22Inv = g1 / (g * (R2 + g) + 1);
-				u12u22Inv = g * u22Inv;
+		ParameterQueue<Type, 5> events{};
+	};
 
-				a1 = -2 * R2;
-				a2 = 0;
-				a0 = 1;
+	//==============================================================================
+	/**
+	 * StateVariableFilter with all settings fixed at compile time. The coefficients are
+	 * constants from designSVF with the plain tangent prewarp (the same as the default
+	 * TaylorPrewarper below 16 kHz), evaluated in double by hexa::series. Q and gain are
+	 * std::ratio, e.g. std::ratio<7, 10> for Q = 0.7.
+	 */
+	template <typename Type, StateVariableType type, unsigned cutoffHz, typename Q = std::ratio<7071, 10000>,
+		unsigned sampleRateHz = 48000, typename GainDb = std::ratio<0>>
+	class FixedStateVariableFilter final
+	{
+		static_assert(cutoffHz > 0 && 2 * cutoffHz < sampleRateHz, "Cutoff needs to be in (0, sampleRate / 2)");
+		static_assert(Q::num > 0, "Q needs to be positive");
 
-				break;
+		static constexpr StateVariableCoefficients<double> design = designSVF(type,
+			series::tan(c<double>::pi * cutoffHz / sampleRateHz), 1 / utils::ratioValue<Q>(),
+			series::pow10(utils::ratioValue<GainDb>() / 80));
+
+	public:
+		static constexpr Type g = Type(design.g), l21 = Type(design.l21), u11Inv = Type(design.u11Inv);
+		static constexpr Type u22Inv = Type(design.u22Inv), u12u22Inv = Type(design.u12u22Inv);
+		static constexpr Type a1 = Type(design.a1), a2 = Type(design.a2), a0 = Type(design.a0);
+
+		//==============================================================================
+		static constexpr StateVariableType getType() noexcept { return type; }
+
+		static constexpr Type getCutoff() noexcept { return Type(cutoffHz); }
+
+		static constexpr Type getSampleRate() noexcept { return Type(sampleRateHz); }
+
+		//==============================================================================
+		/** See DenormalMode. */
+		void setDenormalMode(DenormalMode newMode) noexcept { denormals.setMode(newMode); }
+
+		DenormalMode getDenormalMode() const noexcept { return denormals.getMode(); }
+
+		//==============================================================================
+		/** Only allocates the states, sRate has to be the one the filter is designed for. */
+		void prepare([[maybe_unused]] Type sRate, size_t numChannels, [[maybe_unused]] size_t maxBlockSize)
+		{
+			assert(sRate == Type(sampleRateHz));
+			s1.resize(numChannels);
+			s2.resize(numChannels);
+			reset();
+		}
+
+		/** Denormal scope of a block, see Chain::beginBlock(). */
+		auto beginBlock() noexcept
+		{
+			return denormals.protect(s1, s2);
+		}
+
+		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
+		{
+			assert(nChans <= s1.size());
+
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			for (size_t ch = 0; ch < nChans; ++ch)
+			{
+				Type ls1 = s1[ch], ls2 = s2[ch];
+
+				const Type* in = inputs[ch];
+				Type* out = outputs[ch];
+
+				for (size_t n = 0; n < nFrames; ++n)
+				{
+					out[n] = tick(in[n] + dc, ls1, ls2);
+				}
+
+				s1[ch] = ls1; s2[ch] = ls2;
 			}
 		}
 
-		//==============================================================================		
-		Type sampleRate{ 44100. }, cutoff{ 440. }, gain{ 6. }, R2{ c<Type>::sqrt2 };
-		FilterType type{ FilterType::LP };
+		Type processSample(const Type& x, size_t ch) noexcept
+		{
+			assert(ch < s1.size());
+			return tick(x, s1[ch], s2[ch]);
+		}
 
-		Type g{}, a1{}, a2{}, a0{};
-		Type l21{}, u11Inv{}, u22Inv{}, u12u22Inv{};
+		// Same as processSample (introduced for brevity in complex processors), plus the input
+		// offset of an open denormal scope
+		Type operator() (const Type& x, size_t ch) noexcept
+		{
+			return processSample(x + denormals.getInputOffset(), ch);
+		}
 
-		std::vector<Type> s1{ 2 }, s2{ 2 };
+		void reset() noexcept
+		{
+			std::fill(s1.begin(), s1.end(), Type(0));
+			std::fill(s2.begin(), s2.end(), Type(0));
+		}
 
-		Prewarper pw{};
+	private:
+		static Type tick(const Type& x, Type& s1, Type& s2) noexcept
+		{
+			// Same step as StateVariableFilter::tick.
+			Type b1 = g * x + s1, b2 = s2;
+
+			Type z2 = b2 - l21 * b1;
+			Type u2 = z2 * u22Inv, u1 = (b1 - u12u22Inv * z2) * u11Inv;
+
+			s1 = 2 * u1 - s1;
+			s2 = 2 * u2 - s2;
+
+			return a1 * u1 + a2 * u2 + a0 * x;
+		}
+
+		std::vector<Type> s1 = std::vector<Type>(2), s2 = std::vector<Type>(2);
+
+		DenormalProtection<Type> denormals{};
 	};
 }
@@ -2,13 +2,32 @@
 
 #include <vector>
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 
+#include "../core/hexa_Denormals.h"
+#include "../core/hexa_ParameterQueue.h"
+#include "../core/hexa_Silence.h"
+#include "../core/hexa_SolverStats.h"
 #include "../math/hexa_Constants.h"
 
 namespace hexa
 {
-	/** Implementation of a simple symmetrical diode clipped. */
+	enum class DiodeClipperSolver { Newton, Table };
+
+	enum class DiodeClipperParameter { frequency, gain };
+
+	/**
+	 * Implementation of a simple symmetrical diode clipped.
+	 *
+	 * With DiodeClipperSolver::Table the implicit equation p = b * sinh(y / a) + y is
+	 * solved once per cutoff/sample rate change into a cubic Hermite table of y(p) (exact
+	 * slopes, odd symmetry), so a sample costs a table read. The table grows until its
+	 * error against the exact solution is below the tolerance; arguments past the table
+	 * range fall back to Newton. The table is rebuilt (and may reallocate) in setFrequency()
+	 * and prepare(), and on the calling thread by a posted frequency change, which the next
+	 * process() picks up without locks or allocations.
+	 */
 	template <typename Type>
 	class SymDiodeClipper
 	{
@@ -16,9 +35,14 @@ namespace hexa
 		SymDiodeClipper() = default;
 
 		//==============================================================================
-		void setFrequency(Type freqHz) noexcept
+		void setFrequency(Type freqHz)
 		{
-			cutoff = std::clamp(freqHz, Type(20), Type(16.e3));
+			// Frequencies posted before are older, drop them.
+			Type posted;
+			events.take(static_cast<size_t>(DiodeClipperParameter::frequency), posted);
+			tables.clearPending();
+
+			cutoff = clampFrequency(freqHz);
 			update();
 		}
 
@@ -27,6 +51,42 @@ namespace hexa
 			gain = std::pow(Type(10), gainDb / 20);
 		}
 
+		/**
+		 * Lock-free change from one control thread, applied at the start of the next process().
+		 * With the Table solver a frequency change builds its table here (allocates) and hands
+		 * it over, the audio thread only swaps it in.
+		 */
+		void postParameter(DiodeClipperParameter id, Type value)
+		{
+			if (id == DiodeClipperParameter::frequency && solver == DiodeClipperSolver::Table)
+			{
+				buildTable(tables.getWriteBuffer(), clampFrequency(value));
+				tables.publish();
+				return;
+			}
+
+			events.push(static_cast<size_t>(id), value);
+		}
+
+		void setSolver(DiodeClipperSolver newSolver)
+		{
+			if (solver == newSolver) return;
+			solver = newSolver;
+			update();
+		}
+
+		/**
+		 * Sets the max abs error of the table against the exact solution and the range of
+		 * the solver argument it covers (|p| = |G * (x - s) + s|, about |x| at high cutoffs).
+		 */
+		void setTableAccuracy(Type maxError, Type range = Type(8))
+		{
+			assert(maxError > 0 && range > 0);
+			tableTolerance = maxError;
+			tableRange = range;
+			update();
+		}
+
 		//==============================================================================
 		Type getCutoff() const noexcept { return cutoff; }
 
@@ -34,22 +94,94 @@ namespace hexa
 
 		Type getSampleRate() const noexcept { return sampleRate; }
 
+		DiodeClipperSolver getSolver() const noexcept { return solver; }
+
+		/** Measured max error of the current table (at the midpoints of its intervals). */
+		Type getTableError() const noexcept { return tables.getReadBuffer().error; }
+
+		size_t getTableSize() const noexcept { return tables.getReadBuffer().values.size(); }
+
 		//==============================================================================
-		void prepare(Type sRate, size_t numChannels, [[maybe_unused]] size_t maxBlockSize) noexcept
+		/**
+		 * Newton statistics of the last process() call and the processSample() calls since,
+		 * recorded only with HEXA_SOLVER_STATS defined. Table lookups are not counted.
+		 */
+		const SolverStats& getBlockSolverStats() const noexcept { return blockStats; }
+
+		/** Newton statistics since prepare() or resetSolverStats(). */
+		SolverStats getSolverStats() const noexcept
+		{
+			SolverStats all = totalStats;
+			all.merge(blockStats);
+			return all;
+		}
+
+		void resetSolverStats() noexcept
+		{
+			blockStats.clear();
+			totalStats.clear();
+		}
+
+		//==============================================================================
+		/** See DenormalMode. */
+		void setDenormalMode(DenormalMode newMode) noexcept { denormals.setMode(newMode); }
+
+		DenormalMode getDenormalMode() const noexcept { return denormals.getMode(); }
+
+		//==============================================================================
+		/** Skips the silent channels of process(), see SilenceGate. */
+		void setSilenceBypass(bool shouldBypass) noexcept { silence.setEnabled(shouldBypass); }
+
+		void setSilenceThreshold(Type newThreshold) noexcept { silence.setThreshold(newThreshold); }
+
+		bool isSilenceBypassEnabled() const noexcept { return silence.isEnabled(); }
+
+		/**
+		 * Small-signal tail with the diodes linearized, an upper bound as conducting diodes
+		 * only speed up the decay.
+		 */
+		size_t getTailLength() const noexcept { return silence::tailFromPoleRadius(std::abs(2 * (1 - G) / (1 + b * aInv) - 1)); }
+
+		//==============================================================================
+		void prepare(Type sRate, size_t numChannels, [[maybe_unused]] size_t maxBlockSize)
 		{
 			sampleRate = sRate;
 			st.resize(numChannels);
 
 			update();
+			silence.prepare(numChannels);
 			reset();
+			resetSolverStats();
+		}
+
+		/** Posted parameters and denormal scope of a block, see Chain::beginBlock(). */
+		auto beginBlock() noexcept
+		{
+			applyParameters();
+			return denormals.protect(st);
 		}
 
 		void process(const Type** inputs, Type** outputs, size_t nChans, size_t nFrames) noexcept
 		{
 			assert(nChans <= st.size());
 
+			const auto denormalScope = beginBlock();
+			const Type dc = denormals.getInputOffset();
+
+			totalStats.merge(blockStats);
+			blockStats.clear();
+
+			const size_t tail = silence.isEnabled() ? getTailLength() : 0;
+
 			for (size_t ch = 0; ch < nChans; ++ch)
 			{
+				if (silence.canSkip(ch, inputs[ch], nFrames, tail))
+				{
+					std::fill_n(outputs[ch], nFrames, Type(0));
+					st[ch] = 0;
+					continue;
+				}
+
 				auto&& ls = st[ch];
 
 				const Type* in = inputs[ch];
@@ -57,7 +189,7 @@ namespace hexa
 
 				for (size_t n = 0; n < nFrames; ++n)
 				{
-					out[n] = tick(in[n], ls);
+					out[n] = tick(in[n] + dc, ls);
 				}
 			}
 		}
@@ -68,36 +200,88 @@ namespace hexa
 			return tick(x, st[ch]);
 		}
 
-		// Same as processSample (introduced for brevity in complex processors)
+		// Same as processSample (introduced for brevity in complex processors), plus the input
+		// offset of an open denormal scope
 		Type operator() (const Type& x, size_t ch)
 		{
 			assert(ch < st.size());
-			return tick(x, st[ch]);
+			return tick(x + denormals.getInputOffset(), st[ch]);
 		}
 
 		void reset() noexcept
 		{
 			std::fill(st.begin(), st.end(), Type(0));
+			silence.reset();
 		}
 
 	private:
-		Type tick(const Type& in, size_t ch) noexcept
+		void applyParameters() noexcept
 		{
-			auto&& s = st[ch];
+			bool changed = events.drain([this](size_t id, Type value)
+			{
+				switch (static_cast<DiodeClipperParameter>(id))
+				{
+				case DiodeClipperParameter::frequency: cutoff = clampFrequency(value); break;
+				case DiodeClipperParameter::gain: setGain(value); break;
+				}
+			});
+
+			// A table posted with its frequency.
+			if (tables.acquire())
+			{
+				cutoff = tables.getReadBuffer().cutoff;
+				changed = true;
+			}
+
+			if (changed) updateCoefficients();
+		}
+
+		static Type clampFrequency(Type freqHz) noexcept
+		{
+			return std::clamp(freqHz, Type(20), Type(16.e3));
+		}
 
+		Type tick(const Type& in, Type& s) noexcept
+		{
 			const Type p = G * (in * gain - s) + s;
+			const Type y = solver == DiodeClipperSolver::Table ? lookup(p) : solve(p);
+
+			// Update integrator
+			s = 2 * y - s;
+
+			return y;
+		}
 
+		Type solve(Type p) const noexcept
+		{
+			size_t itr = 0;
+			const Type y = newton(p, a, aInv, b, deltaLim, TOL, MAX_NUM_ITERATIONS, &itr);
+
+			if constexpr (SolverStats::enabled)
+			{
+				// The loop counter passes the cap by 2 when it breaks.
+				const bool hitCap = itr > MAX_NUM_ITERATIONS + 1;
+				const Type F = p - b * std::sinh(y * aInv) - y;
+				blockStats.record(hitCap ? itr - 1 : itr, hitCap, std::abs(double(F)));
+			}
+
+			return y;
+		}
+
+		template <typename T>
+		static T newton(T p, T a, T aInv, T b, T deltaLim, T tol, size_t maxNumIterations, size_t* numIterations = nullptr) noexcept
+		{
 			// Capped Newton as described in DAFX-2015 paper (see Ben Holmes)
 			// Set initial guess, step size and iterations counter.
-			Type y = a * std::asinh(p / b);
-			Type delta = 1.e6;
+			T y = a * std::asinh(p / b);
+			T delta = 1.e6;
 			size_t itr = 0;
-			while (std::abs(delta) > TOL)
+			while (std::abs(delta) > tol)
 			{
-				if (itr++ > MAX_NUM_ITERATIONS) break;
+				if (itr++ > maxNumIterations) break;
 
-				const Type F = p - b * std::sinh(y * aInv) - y;
-				const Type dF = -1 - b * aInv * std::cosh(y * aInv);
+				const T F = p - b * std::sinh(y * aInv) - y;
+				const T dF = -1 - b * aInv * std::cosh(y * aInv);
 
 				// Capped step
 				delta = std::clamp(-F / dF, -deltaLim, deltaLim);
@@ -105,13 +289,102 @@ namespace hexa
 				y += delta;
 			}
 
-			// Update integrator
-			s = 2 * y - s;
-
+			if (numIterations != nullptr) *numIterations = itr;
 			return y;
 		}
 
-		void update() noexcept
+		//==============================================================================
+		/** y(p) of a cutoff, with the range and step it was built for. */
+		struct SolutionTable
+		{
+			Type cutoff{}, range{}, scale{}, error{};
+			std::vector<Type> values{}, slopes{};
+		};
+
+		Type lookup(Type p) const noexcept
+		{
+			const auto& table = tables.getReadBuffer();
+
+			const Type absP = std::abs(p);
+			if (absP >= table.range) return solve(p);
+
+			const Type y = interpolate(table, absP);
+			return p < 0 ? -y : y;
+		}
+
+		/** Cubic Hermite (slopes are scaled by the table step), absP below the table range. */
+		static Type interpolate(const SolutionTable& table, Type absP) noexcept
+		{
+			const Type pos = absP * table.scale;
+			const size_t idx = static_cast<size_t>(pos);
+			const Type t = pos - static_cast<Type>(idx);
+
+			const Type y0 = table.values[idx], y1 = table.values[idx + 1];
+			const Type m0 = table.slopes[idx], m1 = table.slopes[idx + 1];
+			const Type d = y1 - y0;
+			return y0 + t * (m0 + t * ((3 * d - 2 * m0 - m1) + t * (m0 + m1 - 2 * d)));
+		}
+
+		/** Fills table for the cutoff at the current sample rate, it only touches table. */
+		void buildTable(SolutionTable& table, Type forCutoff) const
+		{
+			// The exact reference is a double precision Newton run to convergence.
+			const double g = std::tan(c<double>::pi * double(forCutoff) / double(sampleRate));
+			const double da = double(mu * Vt), db = 2 * double(R) * (g / (1 + g)) * double(Is);
+			const double daInv = 1 / da, dLim = da * std::acosh(da / db);
+			const auto exact = [&](double p) { return newton(p, da, daInv, db, dLim, 1.e-15, 100); };
+
+			table.cutoff = forCutoff;
+			table.range = tableRange;
+
+			for (size_t numPoints = minTableSize; ; numPoints *= 2)
+			{
+				const double step = double(tableRange) / double(numPoints - 2);
+				table.scale = static_cast<Type>(1 / step);
+
+				table.values.resize(numPoints);
+				table.slopes.resize(numPoints);
+				for (size_t i = 0; i < numPoints; ++i)
+				{
+					const double y = exact(step * double(i));
+					table.values[i] = static_cast<Type>(y);
+
+					// Implicit derivative: dy/dp = 1 / (b / a * cosh(y / a) + 1)
+					table.slopes[i] = static_cast<Type>(step / (db * daInv * std::cosh(y * daInv) + 1));
+				}
+
+				double maxError = 0;
+				for (size_t i = 0; i + 2 < numPoints; ++i)
+				{
+					const Type p = static_cast<Type>(step * (double(i) + 0.5));
+					maxError = std::max(maxError, std::abs(double(interpolate(table, p)) - exact(double(p))));
+				}
+
+				table.error = static_cast<Type>(maxError);
+				if (maxError <= double(tableTolerance) || numPoints >= maxTableSize) break;
+			}
+		}
+
+		void update()
+		{
+			if (solver == DiodeClipperSolver::Table)
+			{
+				// A frequency posted before this setup call (as a table, or as an event while
+				// the Newton solver was on) is taken over now, the table has to match it.
+				Type posted;
+				if (tables.acquire()) cutoff = tables.getReadBuffer().cutoff;
+				if (events.take(static_cast<size_t>(DiodeClipperParameter::frequency), posted)) cutoff = clampFrequency(posted);
+
+				updateCoefficients();
+				buildTable(tables.getReadBuffer(), cutoff);
+			}
+			else
+			{
+				updateCoefficients();
+			}
+		}
+
+		void updateCoefficients() noexcept
 		{
 			Type g = std::tan(c<Type>::pi * cutoff / sampleRate);
 			G = g / (1 + g);
@@ -128,6 +401,23 @@ namespace hexa
 
 		std::vector<Type> st{};
 
+		DenormalProtection<Type> denormals{};
+		SilenceGate<Type> silence{};
+
+		// Solution table
+		DiodeClipperSolver solver{ DiodeClipperSolver::Newton };
+		Type tableTolerance{ Type(1.e-6) }, tableRange{ 8 };
+		TripleBuffer<SolutionTable> tables{};
+
+		ParameterQueue<Type, 2> events{};
+
+		// Written by the const solve(), they are instrumentation and not state.
+		mutable SolverStats blockStats{};
+		SolverStats totalStats{};
+
+		static constexpr size_t minTableSize = 256;
+		static constexpr size_t maxTableSize = 1 << 16;
+
 		// Parameters for a germanium diode
 		static constexpr Type Is = Type(2.52e-9);
 		static constexpr Type mu = Type(1.752);		// Ideality
@@ -7,12 +7,29 @@
 
 #include "math/hexa_Constants.h"
 #include "math/hexa_Pade.h"
+#include "math/hexa_Series.h"
+#include "math/hexa_Sinc.h"
 #include "math/hexa_Interpolators.h"
 
 #include "core/hexa_General.h"
+#include "core/hexa_Allocators.h"
+#include "core/hexa_ParameterQueue.h"
+#include "core/hexa_SolverStats.h"
+#include "core/hexa_Denormals.h"
+#include "core/hexa_Silence.h"
+#include "core/hexa_Simd.h"
 #include "core/hexa_DataBuffer.h"
+#include "core/hexa_Interleave.h"
 #include "core/hexa_DelayLine.h"
+#include "core/hexa_Chain.h"
+#include "core/hexa_ThreadPool.h"
+#include "core/hexa_ParallelProcessor.h"
+#include "core/hexa_Oversampler.h"
+#include "core/hexa_Resampler.h"
+#include "core/hexa_FFT.h"
+#include "core/hexa_Convolver.h"
 
+#include "filters/hexa_FrequencyResponse.h"
 #include "filters/hexa_Prewarpers.h"
 #include "filters/hexa_OnePoleFilter.h"
 #include "filters/hexa_StateVariableFilter.h"
@@ -20,3 +37,4 @@
 #include "filters/hexa_ActiveOnePoleFilter.h"
 #include "filters/hexa_SymDiodeClipper.h"
 #include "filters/hexa_RBJFilter.h"
+#include "filters/hexa_BiquadCascade.h"
@@ -1,8 +1,44 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+
+#include "../core/hexa_Simd.h"
+#include "hexa_Sinc.h"
+
 namespace hexa
 {
-	enum class InterpolationType { Drop, Linear, Lagrange3, BSpline3, CatmullRom, Opti3, Opti4 };
+	enum class InterpolationType { Drop, Linear, Lagrange3, BSpline3, CatmullRom, Opti3, Opti4, Sinc8, Sinc16, Sinc32, Sinc64 };
+
+	/** The windowed sinc types, see SincInterpolator. */
+	constexpr bool isSincInterpolation(InterpolationType type) noexcept
+	{
+		return type == InterpolationType::Sinc8 || type == InterpolationType::Sinc16
+			|| type == InterpolationType::Sinc32 || type == InterpolationType::Sinc64;
+	}
+
+	// Every polynomial interpolator has a static eval<V>, the same kernel for any V (Type,
+	// double, simd::Batch<Type>). operator() evaluates one point in Type, so float stays float,
+	// and the static evaluate() runs a block of fractions and planar points in SIMD lanes.
+	// The sinc types share a polyphase table instead and take their points as an array.
+
+	namespace interpolation::detail
+	{
+		/** out[i] = kernel(x[i], y[i]...), simd::Batch<Type>::size points at a time. */
+		template <typename Type, typename Kernel, typename... Points>
+		void evaluate(Kernel&& kernel, const Type* x, Type* out, size_t n, const Points*... y) noexcept
+		{
+			using Batch = simd::Batch<Type>;
+
+			const size_t vecLen = n - n % Batch::size;
+			for (size_t i = 0; i < vecLen; i += Batch::size)
+			{
+				kernel(Batch::load(x + i), Batch::load(y + i)...).store(out + i);
+			}
+
+			for (size_t i = vecLen; i < n; ++i) out[i] = kernel(x[i], y[i]...);
+		}
+	}
 
 	template <typename Type, InterpolationType type>
 	struct Interpolator;
@@ -20,6 +56,17 @@ namespace hexa
 		{
 			return y0;
 		}
+
+		template <typename V>
+		static V eval([[maybe_unused]] V x, V y0) noexcept
+		{
+			return y0;
+		}
+
+		static void evaluate([[maybe_unused]] const Type* x, const Type* y0, Type* out, size_t n) noexcept
+		{
+			std::copy_n(y0, n, out);
+		}
 	};
 
 	template <typename Type>
@@ -33,7 +80,18 @@ namespace hexa
 		//==============================================================================
 		Type operator() (double x, Type y0, Type y1) const noexcept
 		{
-			return static_cast<Type>(y1 + x * (y0 - y1));
+			return eval<Type>(static_cast<Type>(x), y0, y1);
+		}
+
+		static void evaluate(const Type* x, const Type* y0, const Type* y1, Type* out, size_t n) noexcept
+		{
+			interpolation::detail::evaluate([](auto... v) { return eval(v...); }, x, out, n, y0, y1);
+		}
+
+		template <typename V>
+		static V eval(V x, V y0, V y1) noexcept
+		{
+			return y1 + x * (y0 - y1);
 		}
 	};
 
@@ -46,13 +104,24 @@ namespace hexa
 		static constexpr size_t numPoints = 4;
 
 		//==============================================================================
-		Type operator()(Type x, Type y0, Type y1, Type y2, Type y3) const noexcept
+		Type operator() (double x, Type y0, Type y1, Type y2, Type y3) const noexcept
+		{
+			return eval<Type>(static_cast<Type>(x), y0, y1, y2, y3);
+		}
+
+		static void evaluate(const Type* x, const Type* y0, const Type* y1, const Type* y2, const Type* y3, Type* out, size_t n) noexcept
 		{
-			const double a = 0.1666666667 * y0 + 0.6666666667 * y1 + 0.1666666667 * y2,
-				b = -0.5 * y0 + 0.5 * y2,
-				c = 0.5 * y0 - y1 + 0.5 * y2,
-				d = -0.1666666667 * y0 + 0.5 * y1 - 0.5 * y2 + 0.1666666667 * y3;
-			return static_cast<Type>(a + x * (b + x * (c + d * x)));;
+			interpolation::detail::evaluate([](auto... v) { return eval(v...); }, x, out, n, y0, y1, y2, y3);
+		}
+
+		template <typename V>
+		static V eval(V x, V y0, V y1, V y2, V y3) noexcept
+		{
+			const V a = V(0.1666666667) * y0 + V(0.6666666667) * y1 + V(0.1666666667) * y2,
+				b = -V(0.5) * y0 + V(0.5) * y2,
+				c = V(0.5) * y0 - y1 + V(0.5) * y2,
+				d = -V(0.1666666667) * y0 + V(0.5) * y1 - V(0.5) * y2 + V(0.1666666667) * y3;
+			return a + x * (b + x * (c + d * x));
 		}
 	};
 
@@ -67,11 +136,22 @@ namespace hexa
 		//==============================================================================
 		Type operator() (double x, Type y0, Type y1, Type y2, Type y3) const noexcept
 		{
-			const double a = y1,
-				b = -0.5 * y0 + 0.5 * y2,
-				c = y0 - 2.5 * y1 + 2. * y2 - 0.5 * y3,
-				d = -0.5 * y0 + 1.5 * y1 - 1.5 * y2 + 0.5 * y3;
-			return static_cast<Type>(a + x * (b + x * (c + d * x)));
+			return eval<Type>(static_cast<Type>(x), y0, y1, y2, y3);
+		}
+
+		static void evaluate(const Type* x, const Type* y0, const Type* y1, const Type* y2, const Type* y3, Type* out, size_t n) noexcept
+		{
+			interpolation::detail::evaluate([](auto... v) { return eval(v...); }, x, out, n, y0, y1, y2, y3);
+		}
+
+		template <typename V>
+		static V eval(V x, V y0, V y1, V y2, V y3) noexcept
+		{
+			const V a = y1,
+				b = -V(0.5) * y0 + V(0.5) * y2,
+				c = y0 - V(2.5) * y1 + V(2.) * y2 - V(0.5) * y3,
+				d = -V(0.5) * y0 + V(1.5) * y1 - V(1.5) * y2 + V(0.5) * y3;
+			return a + x * (b + x * (c + d * x));
 		}
 	};
 
@@ -86,11 +166,22 @@ namespace hexa
 		//==============================================================================
 		Type operator() (double x, Type y0, Type y1, Type y2, Type y3) const noexcept
 		{
-			const double a = y1,
-				b = -0.3333333333 * y0 - 0.5 * y1 + y2 - 0.1666666667 * y3,
-				c = 0.5 * y0 - y1 + 0.5 * y2,
-				d = -0.1666666667 * y0 + 0.5 * y1 - 0.5 * y2 + 0.1666666667 * y3;
-			return static_cast<Type>(a + x * (b + x * (c + d * x)));
+			return eval<Type>(static_cast<Type>(x), y0, y1, y2, y3);
+		}
+
+		static void evaluate(const Type* x, const Type* y0, const Type* y1, const Type* y2, const Type* y3, Type* out, size_t n) noexcept
+		{
+			interpolation::detail::evaluate([](auto... v) { return eval(v...); }, x, out, n, y0, y1, y2, y3);
+		}
+
+		template <typename V>
+		static V eval(V x, V y0, V y1, V y2, V y3) noexcept
+		{
+			const V a = y1,
+				b = -V(0.3333333333) * y0 - V(0.5) * y1 + y2 - V(0.1666666667) * y3,
+				c = V(0.5) * y0 - y1 + V(0.5) * y2,
+				d = -V(0.1666666667) * y0 + V(0.5) * y1 - V(0.5) * y2 + V(0.1666666667) * y3;
+			return a + x * (b + x * (c + d * x));
 		}
 	};
 
@@ -105,11 +196,22 @@ namespace hexa
 		//==============================================================================
 		Type operator() (double x, Type y0, Type y1, Type y2, Type y3) const noexcept
 		{
-			const double a = 0.20345744715566433 * y0 + 0.5924449242027232 * y1 + 0.20184198969656253 * y2 + 0.002240727070748738 * y3,
-				b = -0.49823192036183106 * y0 + 0.03573669883299365 * y1 + 0.45663331520682054 * y2 + 0.005951377567825489 * y3,
-				c = 0.3987650580367404 * y0 - 0.7866488859776489 * y1 + 0.29427887193783475 * y2 + 0.09351548475726523 * y3,
-				d = -0.10174985775982505 * y0 + 0.36030925263849456 * y1 - 0.36030925263849456 * y2 + 0.10174985775982505 * y3;
-			return static_cast<Type>(a + x * (b + x * (c + d * x)));
+			return eval<Type>(static_cast<Type>(x), y0, y1, y2, y3);
+		}
+
+		static void evaluate(const Type* x, const Type* y0, const Type* y1, const Type* y2, const Type* y3, Type* out, size_t n) noexcept
+		{
+			interpolation::detail::evaluate([](auto... v) { return eval(v...); }, x, out, n, y0, y1, y2, y3);
+		}
+
+		template <typename V>
+		static V eval(V x, V y0, V y1, V y2, V y3) noexcept
+		{
+			const V a = V(0.20345744715566433) * y0 + V(0.5924449242027232) * y1 + V(0.20184198969656253) * y2 + V(0.002240727070748738) * y3,
+				b = -V(0.49823192036183106) * y0 + V(0.03573669883299365) * y1 + V(0.45663331520682054) * y2 + V(0.005951377567825489) * y3,
+				c = V(0.3987650580367404) * y0 - V(0.7866488859776489) * y1 + V(0.29427887193783475) * y2 + V(0.09351548475726523) * y3,
+				d = -V(0.10174985775982505) * y0 + V(0.36030925263849456) * y1 - V(0.36030925263849456) * y2 + V(0.10174985775982505) * y3;
+			return a + x * (b + x * (c + d * x));
 		}
 	};
 
@@ -124,12 +226,35 @@ namespace hexa
 		//==============================================================================
 		Type operator() (double x, Type y0, Type y1, Type y2, Type y3) const noexcept
 		{
-			const double a = 0.1882882705853767 * y0 + 0.6234244946593812 * y1 + 0.18828618868306463 * y2 + 1.0459580992439044e-6 * y3,
-				b = -0.521495184193515 * y0 + 0.06456923251842608 * y1 + 0.43534733489266775 * y2 + 0.021578619812177235 * y3,
-				c = 0.4995463562127711 * y0 - 0.9990450958317605 * y1 + 0.49945043290341395 * y2 + 0.00004829195935707187 * y3,
-				d = -0.16617743854192843 * y0 + 0.49917660509564427 * y1 - 0.49982041406113864 * y2 + 0.16682127096034755 * y3,
-				e = -0.00016095810460478 * y0 + 0.0001609522413736 * y1 + 0.0001609522413736 * y2 - 0.00016095810460478 * y3;
-			return static_cast<Type>(a + x * (b + x * (c + x * (d + e * x))));
+			return eval<Type>(static_cast<Type>(x), y0, y1, y2, y3);
+		}
+
+		static void evaluate(const Type* x, const Type* y0, const Type* y1, const Type* y2, const Type* y3, Type* out, size_t n) noexcept
+		{
+			interpolation::detail::evaluate([](auto... v) { return eval(v...); }, x, out, n, y0, y1, y2, y3);
+		}
+
+		template <typename V>
+		static V eval(V x, V y0, V y1, V y2, V y3) noexcept
+		{
+			const V a = V(0.1882882705853767) * y0 + V(0.6234244946593812) * y1 + V(0.18828618868306463) * y2 + V(1.0459580992439044e-6) * y3,
+				b = -V(0.521495184193515) * y0 + V(0.06456923251842608) * y1 + V(0.43534733489266775) * y2 + V(0.021578619812177235) * y3,
+				c = V(0.4995463562127711) * y0 - V(0.9990450958317605) * y1 + V(0.49945043290341395) * y2 + V(0.00004829195935707187) * y3,
+				d = -V(0.16617743854192843) * y0 + V(0.49917660509564427) * y1 - V(0.49982041406113864) * y2 + V(0.16682127096034755) * y3,
+				e = -V(0.00016095810460478) * y0 + V(0.0001609522413736) * y1 + V(0.0001609522413736) * y2 - V(0.00016095810460478) * y3;
+			return a + x * (b + x * (c + x * (d + e * x)));
 		}
 	};
-}
\ No newline at end of file
+
+	template <typename Type>
+	struct Interpolator<Type, InterpolationType::Sinc8> : SincInterpolator<Type, 8> {};
+
+	template <typename Type>
+	struct Interpolator<Type, InterpolationType::Sinc16> : SincInterpolator<Type, 16> {};
+
+	template <typename Type>
+	struct Interpolator<Type, InterpolationType::Sinc32> : SincInterpolator<Type, 32> {};
+
+	template <typename Type>
+	struct Interpolator<Type, InterpolationType::Sinc64> : SincInterpolator<Type, 64> {};
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "hexa_Constants.h"
+
+namespace hexa::series
+{
+	// constexpr counterparts of std::sin/cos/tan/exp for compile-time filter design. Taylor
+	// series after range reduction, accurate to a few ulp in double; not meant for audio rate.
+
+	//==============================================================================
+	/** Reduces x to [-pi, pi]. */
+	template <typename T>
+	constexpr T reducePi(T x) noexcept
+	{
+		const T turns = x * c<T>::reciprPi / 2;
+		const long long k = static_cast<long long>(turns < 0 ? turns - T(0.5) : turns + T(0.5));
+		return x - T(k) * c<T>::twoPi;
+	}
+
+	template <typename T>
+	constexpr T sin(T x) noexcept
+	{
+		x = reducePi(x);
+		const T x2 = x * x;
+		T term = x, sum = x;
+		for (int n = 1; n < 16; ++n)
+		{
+			term *= -x2 / T((2 * n) * (2 * n + 1));
+			sum += term;
+		}
+		return sum;
+	}
+
+	template <typename T>
+	constexpr T cos(T x) noexcept
+	{
+		x = reducePi(x);
+		const T x2 = x * x;
+		T term = 1, sum = 1;
+		for (int n = 1; n < 16; ++n)
+		{
+			term *= -x2 / T((2 * n - 1) * (2 * n));
+			sum += term;
+		}
+		return sum;
+	}
+
+	template <typename T>
+	constexpr T tan(T x) noexcept
+	{
+		return sin(x) / cos(x);
+	}
+
+	//==============================================================================
+	/** e^x as 2^k * e^r with |r| <= ln(2) / 2. */
+	template <typename T>
+	constexpr T exp(T x) noexcept
+	{
+		const T kf = x / c<T>::ln2;
+		const long long k = static_cast<long long>(kf < 0 ? kf - T(0.5) : kf + T(0.5));
+		const T r = x - T(k) * c<T>::ln2;
+
+		T term = 1, sum = 1;
+		for (int n = 1; n < 20; ++n)
+		{
+			term *= r / T(n);
+			sum += term;
+		}
+
+		for (long long i = 0; i < k; ++i) sum *= 2;
+		for (long long i = 0; i > k; --i) sum /= 2;
+		return sum;
+	}
+
+	/** 10^x */
+	template <typename T>
+	constexpr T pow10(T x) noexcept
+	{
+		return exp(x * c<T>::ln10);
+	}
+}
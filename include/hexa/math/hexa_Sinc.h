@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../core/hexa_Simd.h"
+#include "hexa_Constants.h"
+
+namespace hexa
+{
+	/**
+	 * Polyphase table of a Kaiser windowed sinc fractional delay with numTaps points and
+	 * numPhases phases per sample. Every phase keeps its kernel and the difference to the
+	 * next phase, so a read blends the two nearest phases linearly at one extra FMA per tap.
+	 * Kernels are in oldest point first order and normalized to unity DC gain. The cutoff is
+	 * relative to the Nyquist frequency, below 1 the kernels also low-pass (downsampling).
+	 */
+	template <typename Type>
+	class SincTable
+	{
+	public:
+		SincTable(size_t newNumTaps, size_t newNumPhases, double newCutoff = 1.)
+			: numTaps{ newNumTaps }, numPhases{ newNumPhases }, cutoff{ newCutoff }, coeffs(2 * newNumTaps * newNumPhases)
+		{
+			assert(numTaps >= 4 && numTaps % 4 == 0 && numPhases > 0);
+			assert(cutoff > 0 && cutoff <= 1);
+
+			std::vector<double> current(numTaps), next(numTaps);
+			design(0., current.data());
+
+			for (size_t p = 0; p < numPhases; ++p)
+			{
+				design(double(p + 1) / double(numPhases), next.data());
+
+				Type* h = &coeffs[2 * numTaps * p];
+				for (size_t m = 0; m < numTaps; ++m)
+				{
+					h[m] = static_cast<Type>(current[m]);
+					h[numTaps + m] = static_cast<Type>(next[m] - current[m]);
+				}
+
+				std::swap(current, next);
+			}
+		}
+
+		/** Table shared by all users of the same size, built on the first request (allocates, locks). */
+		static std::shared_ptr<const SincTable> get(size_t numTaps, size_t numPhases, double cutoff = 1.)
+		{
+			static std::mutex mutex;
+			static std::vector<std::shared_ptr<const SincTable>> tables;
+
+			std::lock_guard<std::mutex> lock(mutex);
+			for (auto&& t : tables)
+			{
+				if (t->getNumTaps() == numTaps && t->getNumPhases() == numPhases && t->getCutoff() == cutoff) return t;
+			}
+
+			tables.push_back(std::make_shared<const SincTable>(numTaps, numPhases, cutoff));
+			return tables.back();
+		}
+
+		//==============================================================================
+		size_t getNumTaps() const noexcept { return numTaps; }
+
+		size_t getNumPhases() const noexcept { return numPhases; }
+
+		double getCutoff() const noexcept { return cutoff; }
+
+		/** Kaiser beta of the window, more taps afford a wider main lobe. */
+		static double getBeta(size_t numTaps) noexcept
+		{
+			return numTaps <= 8 ? 4.5 : numTaps <= 16 ? 6.5 : numTaps <= 32 ? 8.5 : 10.;
+		}
+
+		//==============================================================================
+		/** Kernel of the fraction in [0, 1) at kernel[0 ... numTaps - 1]. */
+		void getKernel(Type frac, Type* kernel) const noexcept
+		{
+			Type u;
+			const Type* h = getPhase(frac, u);
+			for (size_t m = 0; m < numTaps; ++m) kernel[m] = h[m] + u * h[numTaps + m];
+		}
+
+		/** Interpolated value of the numTaps points at x (oldest first) for the fraction in [0, 1). */
+		Type dot(Type frac, const Type* x) const noexcept
+		{
+			using Batch = simd::Batch<Type>;
+
+			Type u;
+			const Type* h = getPhase(frac, u);
+			const auto vu = Batch::broadcast(u);
+
+			auto acc = Batch::broadcast(Type(0));
+			for (size_t m = 0; m < numTaps; m += Batch::size)
+			{
+				acc = acc + (Batch::load(h + m) + vu * Batch::load(h + numTaps + m)) * Batch::load(x + m);
+			}
+
+			return sum(acc);
+		}
+
+		/** sum of kernel[m] * x[m] over the taps. */
+		Type dotKernel(const Type* kernel, const Type* x) const noexcept
+		{
+			using Batch = simd::Batch<Type>;
+
+			auto acc = Batch::broadcast(Type(0));
+			for (size_t m = 0; m < numTaps; m += Batch::size)
+			{
+				acc = acc + Batch::load(kernel + m) * Batch::load(x + m);
+			}
+
+			return sum(acc);
+		}
+
+		/** out[k] = dotKernel(kernel, x + k) for k < n, SIMD lanes over k instead of the taps. */
+		void convolve(const Type* kernel, const Type* x, Type* out, size_t n) const noexcept
+		{
+			using Batch = simd::Batch<Type>;
+
+			const size_t vecLen = n - n % Batch::size;
+			for (size_t k = 0; k < vecLen; k += Batch::size)
+			{
+				auto acc = Batch::broadcast(Type(0));
+				for (size_t m = 0; m < numTaps; ++m) acc = acc + Batch::broadcast(kernel[m]) * Batch::load(x + k + m);
+				acc.store(out + k);
+			}
+
+			for (size_t k = vecLen; k < n; ++k) out[k] = dotKernel(kernel, x + k);
+		}
+
+	private:
+		const Type* getPhase(Type frac, Type& u) const noexcept
+		{
+			const Type pos = frac * static_cast<Type>(numPhases);
+			const size_t p = std::min(static_cast<size_t>(pos), numPhases - 1);
+			u = pos - static_cast<Type>(p);
+			return &coeffs[2 * numTaps * p];
+		}
+
+		template <typename Batch>
+		static Type sum(Batch acc) noexcept
+		{
+			alignas(64) Type lanes[Batch::size];
+			acc.store(lanes);
+
+			Type s = 0;
+			for (size_t l = 0; l < Batch::size; ++l) s += lanes[l];
+			return s;
+		}
+
+		/** sinc(cutoff * t) * kaiser(t) at t = m - numTaps / 2 + frac, so frac 0 is the point numTaps / 2. */
+		void design(double frac, double* kernel) const noexcept
+		{
+			const double halfLength = double(numTaps) / 2, beta = getBeta(numTaps);
+
+			double dc = 0;
+			for (size_t m = 0; m < numTaps; ++m)
+			{
+				const double t = double(m) - halfLength + frac;
+				const double r = t / halfLength;
+				const double window = besselI0(beta * std::sqrt(std::max(0., 1 - r * r))) / besselI0(beta);
+				const double sinc = t == 0 ? 1. : std::sin(c<double>::pi * cutoff * t) / (c<double>::pi * cutoff * t);
+
+				kernel[m] = sinc * window;
+				dc += kernel[m];
+			}
+
+			for (size_t m = 0; m < numTaps; ++m) kernel[m] /= dc;
+		}
+
+		static double besselI0(double x) noexcept
+		{
+			double term = 1, sum = 1;
+			for (int k = 1; k < 50 && term > 1.e-17 * sum; ++k)
+			{
+				const double h = x / (2 * k);
+				term *= h * h;
+				sum += term;
+			}
+			return sum;
+		}
+
+		size_t numTaps, numPhases;
+		double cutoff;
+		std::vector<Type> coeffs;
+	};
+
+	//==============================================================================
+	/**
+	 * Windowed sinc interpolation over NumTaps points. Like the cubic interpolators it goes
+	 * from the point y[NumTaps / 2 - 1] at x = 0 to y[NumTaps / 2] at x = 1 (y[0] newest),
+	 * so a DelayLine read is NumTaps / 2 - 2 samples later than with the cubic types.
+	 */
+	template <typename Type, size_t NumTaps>
+	class SincInterpolator
+	{
+	public:
+		static_assert(NumTaps >= 8 && NumTaps <= 64 && NumTaps % 8 == 0, "8 to 64 taps in steps of 8");
+
+		static constexpr size_t order = NumTaps - 1;
+
+		static constexpr size_t numPoints = NumTaps;
+
+		static constexpr size_t defaultNumPhases = 512;
+
+		SincInterpolator() : table{ SincTable<Type>::get(NumTaps, defaultNumPhases) } {}
+
+		//==============================================================================
+		/** Switches to the shared table of numPhases phases (allocates on its first use). */
+		void setNumPhases(size_t numPhases)
+		{
+			table = SincTable<Type>::get(NumTaps, numPhases);
+		}
+
+		size_t getNumPhases() const noexcept { return table->getNumPhases(); }
+
+		const SincTable<Type>& getTable() const noexcept { return *table; }
+
+		//==============================================================================
+		/** Interpolates the NumTaps points at oldest (oldest point first) at the fraction x. */
+		Type operator() (double x, const Type* oldest) const noexcept
+		{
+			return table->dot(static_cast<Type>(x), oldest);
+		}
+
+	private:
+		std::shared_ptr<const SincTable<Type>> table;
+	};
+}